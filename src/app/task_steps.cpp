@@ -0,0 +1,116 @@
+#include "task_steps.h"
+
+#include "../display/lv_setup.h"
+#include "../sensors/loadcell.h"
+#include "../ui/ui_update.h"
+#include "../ui/ui_touch_cal.h"
+#include "../diag/profiler.h"
+
+/* ── Sensor task ──────────────────────────────────────────── */
+
+bool sensor_task_step(SensorRing &ring, SensorData &out)
+{
+    pressure_cg_t pressure    = 0;
+    uint32_t      timestampUs = 0;
+    bool        isNew = loadcell_read(pressure, timestampUs);
+    SensorEvent event = loadcell_take_event();
+
+    if (!isNew && event == SensorEvent::NONE) return false;
+
+    LoadcellRaw raw;
+    loadcell_get_raw(raw);
+    out = { pressure, timestampUs, isNew, raw.counts, raw.unfiltered, event };
+    ring.push(out);
+    return true;
+}
+
+/* ── Logic task ───────────────────────────────────────────── */
+
+LogicStepResult logic_task_step(PressTimer &timer, SensorRing &ring, QueueHandle_t actions,
+                                const LogicTaskHooks &hooks)
+{
+    LogicStepResult result = { false, false };
+
+    /* Drain every sample that arrived since the last wakeup, in order */
+    PROF_DEPTH(SENSOR_RING, ring.size());
+    SensorData batch[LOGIC_BATCH_SIZE];
+    size_t n;
+    while ((n = ring.popBatch(batch, LOGIC_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (batch[i].event != SensorEvent::NONE) {
+                timer.processSensorEvent(batch[i].event);
+            }
+            if (batch[i].isValid) {
+                timer.processPressure(batch[i].pressure, batch[i].timestampUs);
+                result.gotPressure = true;
+
+                if (hooks.sample) {
+                    TelemetrySample sample = {
+                        batch[i].timestampUs, batch[i].rawCounts, batch[i].unfiltered,
+                        batch[i].pressure, (uint8_t)timer.getState()
+                    };
+                    hooks.sample(sample, hooks.ctx);
+                }
+            }
+        }
+    }
+
+    /* Check for user actions */
+    PROF_DEPTH(ACTION_QUEUE, uxQueueMessagesWaiting(actions));
+    UserAction action;
+    while (xQueueReceive(actions, &action, 0) == pdTRUE) {
+        if (action.type == UserActionType::TARE) {
+            loadcell_request_tare();
+        }
+        timer.processAction(action);
+        if (hooks.action) hooks.action(action, timer, hooks.ctx);
+    }
+
+    /* Time-driven transitions, then one snapshot per wakeup */
+    timer.tick();
+    result.published = timer.publish();
+    return result;
+}
+
+/* ── UI task ──────────────────────────────────────────────── */
+
+void ui_task_apply_snapshot(const AppSnapshotChannel &channel, UiShownState &state,
+                            UiCommandSink sink, void *ctx)
+{
+    if (channel.version() == state.version) return;
+    state.version = channel.version();
+
+    AppSnapshot snap;
+    if (!channel.read(snap)) return;
+
+    UICommand changes[APP_SNAPSHOT_MAX_CHANGES];
+    size_t n = app_snapshot_diff(state.haveShown ? &state.shown : nullptr, snap, changes);
+    for (size_t i = 0; i < n; i++) {
+        sink(changes[i], ctx);
+    }
+    state.shown     = snap;
+    state.haveShown = true;
+}
+
+bool ui_task_frame(uint32_t &nextTimerMs)
+{
+    /* Smooth arc animation (local timing, every frame) */
+    ui_arc_tick();
+    ui_touch_cal_poll();
+
+    bool fullRate = !UI_ADAPTIVE_REFRESH || ui_needs_full_rate() ||
+                    ui_touch_cal_active() || lv_setup_touch_active();
+    lv_setup_set_idle(!fullRate);
+
+    /* Drive LVGL (rendering, animations, input) */
+    nextTimerMs = lv_setup_update();
+    return fullRate;
+}
+
+uint32_t ui_task_idle_sleep_ms(uint32_t nextTimerMs)
+{
+    uint32_t sleepMs = nextTimerMs;
+    if (sleepMs > UI_IDLE_MAX_SLEEP_MS) sleepMs = UI_IDLE_MAX_SLEEP_MS;
+    if (sleepMs < UI_REFRESH_PERIOD_MS) sleepMs = UI_REFRESH_PERIOD_MS;
+    return sleepMs;
+}
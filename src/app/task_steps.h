@@ -0,0 +1,86 @@
+#ifndef TASK_STEPS_H
+#define TASK_STEPS_H
+
+#include <stdint.h>
+
+#include "../config.h"
+#include "../logic/app_state.h"
+#include "../logic/press_timer.h"
+#include "../logic/app_snapshot.h"
+#include "../diag/telemetry_frame.h"
+#include "../util/spsc_ring.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+/**
+ * One iteration of each task body, shared by the FreeRTOS tasks in
+ * main.cpp and the cooperative SimApp. The callers keep only what is
+ * platform specific: how a task sleeps and is woken, the deadline timer,
+ * settings, the boot timeline.
+ */
+
+typedef SpscRing<SensorData, SENSOR_RING_SIZE> SensorRing;
+
+/* ── Sensor task ──────────────────────────────────────────── */
+
+/**
+ * Read the conversion loadcell_wait() (or the sim) made ready and queue
+ * it for the logic task, together with any tare result.
+ * @param out  What was pushed, when the return value is true
+ * @return true if the logic task has something new to process
+ */
+bool sensor_task_step(SensorRing &ring, SensorData &out);
+
+/* ── Logic task ───────────────────────────────────────────── */
+
+struct LogicTaskHooks {
+    /** Every valid sample, after the state machine saw it (nullptr = off) */
+    void (*sample)(const TelemetrySample &sample, void *ctx);
+    /** After each user action was applied (nullptr = off) */
+    void (*action)(const UserAction &action, const PressTimer &timer, void *ctx);
+    void *ctx;
+};
+
+struct LogicStepResult {
+    bool published;     // A new snapshot is out; wake the UI if it is idle
+    bool gotPressure;   // At least one valid sample was processed
+};
+
+/**
+ * Drain the sensor ring and the action queue in order, run the
+ * time-driven transitions and publish one snapshot. The caller re-arms
+ * its wakeup from timer.nextDeadline() afterwards.
+ */
+LogicStepResult logic_task_step(PressTimer &timer, SensorRing &ring, QueueHandle_t actions,
+                                const LogicTaskHooks &hooks);
+
+/* ── UI task ──────────────────────────────────────────────── */
+
+/** Last snapshot the UI applied */
+struct UiShownState {
+    AppSnapshot shown     = {};
+    bool        haveShown = false;
+    uint32_t    version   = 0;
+};
+
+typedef void (*UiCommandSink)(const UICommand &cmd, void *ctx);
+
+/**
+ * Hand every field that changed since the last applied snapshot to sink
+ * (ui_handle_command on the device). No-op while the version is unchanged.
+ */
+void ui_task_apply_snapshot(const AppSnapshotChannel &channel, UiShownState &state,
+                            UiCommandSink sink, void *ctx);
+
+/**
+ * Animate and render one frame.
+ * @param nextTimerMs  ms until LVGL's next timer is due
+ * @return true to keep the full frame rate, false if the task may sleep
+ */
+bool ui_task_frame(uint32_t &nextTimerMs);
+
+/** How long an idle UI task sleeps, given LVGL's next timer */
+uint32_t ui_task_idle_sleep_ms(uint32_t nextTimerMs);
+
+#endif /* TASK_STEPS_H */
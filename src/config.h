@@ -19,24 +19,86 @@
  *====================*/
 #define SCREEN_WIDTH   320
 #define SCREEN_HEIGHT  240
+#ifndef DISPLAY_USE_DMA
+#define DISPLAY_USE_DMA    1    /* 1 = DMA flush overlapping LVGL rendering, 0 = blocking pushColors */
+#endif
+#define FRAME_STATS_REPORT 0    /* 1 = print frame timing every second */
+
+/* Draw buffers: LVGL renders into these and flush_cb sends them to the panel */
+#define DISPLAY_RENDER_PARTIAL 0    /* Dirty areas rendered in stripes of DISPLAY_BUF_LINES rows */
+#define DISPLAY_RENDER_DIRECT  1    /* Screen-sized buffer, dirty areas rendered in place, flushed once per frame */
+#define DISPLAY_RENDER_FULL    2    /* Screen-sized buffer, whole screen redrawn and flushed every frame */
+#ifndef DISPLAY_RENDER_MODE
+#define DISPLAY_RENDER_MODE    DISPLAY_RENDER_PARTIAL
+#endif
+#ifndef DISPLAY_BUF_LINES
+#define DISPLAY_BUF_LINES  20   /* Stripe height in rows (PARTIAL only; DIRECT/FULL use SCREEN_HEIGHT) */
+#endif
+#ifndef DISPLAY_BUF_COUNT
+#define DISPLAY_BUF_COUNT  2    /* 2 = render into one buffer while the other flushes, 1 = render then flush */
+#endif
+#ifndef DISPLAY_BUF_PSRAM
+#define DISPLAY_BUF_PSRAM  0    /* 1 = buffers in PSRAM (boards that have it; SPI DMA can't read PSRAM) */
+#endif
 
 /*====================
    TOUCH CALIBRATION
  *====================*/
+/* Raw bounds used until the calibration screen has been run (then NVS) */
 #define TOUCH_MIN_X    200      /* Raw XPT2046 X minimum */
 #define TOUCH_MAX_X    3700     /* Raw XPT2046 X maximum */
 #define TOUCH_MIN_Y    240      /* Raw XPT2046 Y minimum */
 #define TOUCH_MAX_Y    3800     /* Raw XPT2046 Y maximum */
 
+#define TOUCH_CAL_MARGIN        30    /* Target inset from the screen edges (px) */
+#define TOUCH_CAL_HOLD_MS       150   /* A target press must last this long to count */
+#define TOUCH_CAL_LONG_PRESS_MS 5000  /* Holding the pressure card this long opens calibration */
+
+/*====================
+   TOUCH INPUT
+ *====================*/
+#define TOUCH_SAMPLE_MS       5     /* Read period while the panel is touched (idle: no SPI at all) */
+#define TOUCH_BURST           3     /* X/Y conversions per read (one SPI transaction) */
+#define TOUCH_MEDIAN_WINDOW   5     /* Conversions in the X/Y median, odd ≤ 7 */
+#define TOUCH_Z_MIN           150   /* Lowest pressure taken as a touch (XPT2046 library: 400, too hard for gloves) */
+#define TOUCH_RELEASE_SAMPLES 3     /* Low-pressure reads in a row that end a touch */
+#define TOUCH_IIR_ALPHA_Q8    128   /* Smoothing while held, 256 = off */
+
 /*====================
    LOAD CELL
  *====================*/
 #define LOADCELL_CAL_FACTOR     200.0f
-#define LOADCELL_STABILIZE_MS   2000
+#define LOADCELL_STABILIZE_MS   500     /* Power-up settle before the boot tare (HX711: 4 conversions at 10 SPS) */
 #define LOADCELL_SAMPLES        1       /* HX711 smoothing (1 = no averaging) */
 #define LOADCELL_TARE_TIMEOUT_MS 2000   /* Max wait for tare completion */
+#define LOADCELL_TARE_SAMPLES   8       /* Conversions gathered per tare (outliers rejected) */
+#define LOADCELL_TARE_MAX_NOISE_G 20.0f /* Tare fails if the plate moves more than this (robust σ) */
+#define LOADCELL_FAST_BOOT      1       /* Boot with the saved tare offset when it still reads zero */
+#define LOADCELL_FAST_STABILIZE_MS 300  /* Power-up settle time on the fast path */
+#define LOADCELL_FAST_BOOT_SAMPLES 4    /* Conversions averaged to check the saved zero */
+#define LOADCELL_FAST_BOOT_TOLERANCE_G 10.0f /* Max |reading| to accept the saved zero;
+                                             * < half PRESSURE_RELEASE_THRESHOLD */
 #define SENSOR_READ_INTERVAL_MS 100     /* 10 Hz sensor polling */
 
+/* Acquisition mode: how the sensor task learns a conversion is ready */
+#define LOADCELL_ACQ_POLL       0       /* Poll DT every SENSOR_READ_INTERVAL_MS */
+#define LOADCELL_ACQ_IRQ        1       /* DT falling-edge ISR wakes the sensor task */
+#ifndef LOADCELL_ACQ_MODE
+#define LOADCELL_ACQ_MODE       LOADCELL_ACQ_IRQ
+#endif
+#define LOADCELL_IRQ_TIMEOUT_MS 500     /* IRQ mode: re-check DT if no edge arrives */
+#define LOADCELL_STATS_REPORT   0       /* 1 = print acquisition stats every second */
+
+/* Digital filter chain (sensors/filter.h), applied per sample in the
+ * sensor task; adjustable at runtime with loadcell_set_filter() */
+#define FILTER_MEDIAN_WINDOW    3       /* 0/1 = off, odd ≤ 7: spike rejection */
+#define FILTER_IIR_ALPHA        0.5f    /* one-pole IIR weight, 0 = off, 1 = passthrough */
+#define FILTER_IIR_BYPASS_G     100.0f  /* a drop this far below the IIR output resets it
+                                         * (release shows at once), 0 = never */
+#define FILTER_KALMAN_ENABLED   0       /* 1-D Kalman stage after the IIR */
+#define FILTER_KALMAN_Q         1.0e5f  /* process noise, cg² per sample */
+#define FILTER_KALMAN_R         1.0e6f  /* measurement noise, cg² (≈ 10 g σ) */
+
 /*====================
    PRESS AREA (for bar calculation)
  *====================*/
@@ -47,6 +109,10 @@
    PRESSURE / TIMER
  *====================*/
 #define PRESSURE_THRESHOLD      50.0f   /* grams to trigger "pressing" */
+#define PRESSURE_RELEASE_THRESHOLD 30.0f /* grams to end it (hysteresis) */
+#define PRESS_ENGAGE_DWELL_MS   100     /* must stay above threshold this long */
+#define PRESS_RELEASE_DWELL_MS  200     /* must stay below release this long */
+#define PRESS_TARE_GRACE_MS     1000    /* leave CALIBRATING anyway if no tare result arrives */
 #define TIMER_DEFAULT_SECONDS   15      /* default countdown duration */
 #define TIMER_MIN_SECONDS       5       /* minimum timer setting */
 #define TIMER_MAX_SECONDS       300     /* maximum timer setting */
@@ -56,7 +122,6 @@
    ALERT
  *====================*/
 #define ALERT_BLINK_INTERVAL_MS 500     /* Visual + audio blink period */
-#define LOGIC_TICK_INTERVAL_MS  100     /* State machine update rate */
 
 /*====================
    BUZZER / AUDIO
@@ -71,21 +136,69 @@
 #define UI_TASK_STACK_SIZE      8192
 #define SENSOR_TASK_STACK_SIZE  4096
 #define LOGIC_TASK_STACK_SIZE   4096
+#define TOUCH_TASK_STACK_SIZE   2048
 
 #define UI_TASK_PRIORITY        3
 #define SENSOR_TASK_PRIORITY    2
 #define LOGIC_TASK_PRIORITY     2
+#define TOUCH_TASK_PRIORITY     4    /* Short SPI bursts, only while touched */
 
 #define UI_TASK_CORE            1
 #define SENSOR_TASK_CORE        0
 #define LOGIC_TASK_CORE         0
+#define TOUCH_TASK_CORE         1
+
+#ifndef RTOS_STATIC_ALLOC
+#define RTOS_STATIC_ALLOC       1    /* 1 = task stacks/TCBs and queues in .bss, 0 = FreeRTOS heap */
+#endif
 
-#define QUEUE_SIZE              8
+#define QUEUE_SIZE              8    /* UserAction queue */
+#define SENSOR_RING_SIZE        32   /* SensorData ring, power of two (~3 s at 10 SPS) */
+#define LOGIC_BATCH_SIZE        8    /* Samples drained per ring pop */
+
+/*====================
+   DIAGNOSTICS
+ *====================*/
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED        0    /* 1 = build probes + "prof" console command */
+#endif
+#define PROFILER_STREAM_MS      0    /* Print the profile this often (0 = on command only) */
+#define CONSOLE_POLL_MS         50   /* Serial console poll period (loop task) */
+#define BOOT_TIMELINE_TIMEOUT_MS 20000 /* Print the boot timeline by then even if it never completed */
+#define MEM_REPORT_BOOT_MS      10000 /* Print the memory report this long after boot (0 = only on "mem") */
+#define MEM_REPORT_LV_SAMPLE_MS 1000 /* UI task refreshes the LVGL pool figures this often */
+
+#define TELEMETRY_DEFAULT_ON    0    /* 1 = stream binary samples from boot ("telem on") */
+#define TELEMETRY_RING_SIZE     256  /* Samples buffered for the writer, power of two (~3 s at 80 SPS) */
+#define TELEMETRY_BATCH_SIZE    16   /* Frames per UART write */
+#define TELEMETRY_FLUSH_MS      50   /* Writer task period */
+#define TELEMETRY_TASK_STACK_SIZE 3072
+#define TELEMETRY_TASK_PRIORITY 1    /* Below every real-time task */
+#define TELEMETRY_TASK_CORE     0
+
+/*====================
+   PRESS CYCLE LOG (LittleFS "spiffs" partition)
+ *====================*/
+#define CYCLELOG_QUEUE_SIZE      16     /* Finished cycles buffered in RAM, power of two */
+#define CYCLELOG_BATCH           8      /* Write once this many cycles are queued... */
+#define CYCLELOG_FLUSH_MS        60000  /* ...or the oldest has waited this long */
+#define CYCLELOG_SEGMENT_RECORDS 128    /* 32-byte records per segment file (one 4 kB block) */
+#define CYCLELOG_MAX_SEGMENTS    16     /* Ring size: 2048 cycles, 64 kB */
+
+/*====================
+   SETTINGS (NVS)
+ *====================*/
+#define SETTINGS_COMMIT_DELAY_MS 3000   /* Commit once changes have been quiet this long */
 
 /*====================
    UI REFRESH
  *====================*/
 #define UI_REFRESH_PERIOD_MS    33   /* ~30 fps */
+#ifndef UI_ADAPTIVE_REFRESH
+#define UI_ADAPTIVE_REFRESH     1    /* 1 = sleep while nothing animates, 0 = fixed 30 fps */
+#endif
+#define UI_IDLE_MAX_SLEEP_MS    500  /* Longest idle sleep between LVGL runs */
+#define UI_TOUCH_HOLD_MS        3000 /* Stay at full rate this long after the last touch */
 
 /*====================
    MATERIAL COLORS (LVGL format: 0xRRGGBB)
@@ -0,0 +1,67 @@
+#include "boot_timeline.h"
+#include "console.h"
+#include "../config.h"
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+static const char *const MARK_NAMES[(int)BootMark::COUNT] = {
+    "setup", "tasks started", "display ready", "main screen",
+    "loadcell ready", "first sample", "pressure published", "pressure shown",
+};
+
+/* µs since app start, 0 = not reached. Aligned 32-bit stores are atomic */
+static volatile uint32_t marks[(int)BootMark::COUNT];
+static bool printed = false;
+
+/* ── Console ─────────────────────────────────────────────── */
+
+static void cmd_boot(const char *args)
+{
+    boot_timeline_print();
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+void boot_mark(BootMark mark)
+{
+    if (marks[(int)mark] != 0) return;
+    uint32_t us = (uint32_t)esp_timer_get_time();
+    marks[(int)mark] = us ? us : 1;
+}
+
+bool boot_reached(BootMark mark)
+{
+    return marks[(int)mark] != 0;
+}
+
+void boot_timeline_init()
+{
+    console_register("boot", "Boot timeline (ms since app start)", cmd_boot);
+}
+
+void boot_timeline_poll()
+{
+    if (printed) return;
+    if (boot_reached(BootMark::PRESSURE_SHOWN) || millis() >= BOOT_TIMELINE_TIMEOUT_MS) {
+        printed = true;
+        boot_timeline_print();
+    }
+}
+
+void boot_timeline_print()
+{
+    Serial.printf("%-20s %9s %9s\n", "boot", "t (ms)", "+ (ms)");
+    uint32_t prevUs = 0;
+    for (int i = 0; i < (int)BootMark::COUNT; i++) {
+        uint32_t us = marks[i];
+        if (us == 0) {
+            Serial.printf("%-20s %9s %9s\n", MARK_NAMES[i], "-", "-");
+            continue;
+        }
+        /* Milestones of different tasks overlap; deltas can be negative */
+        Serial.printf("%-20s %9.1f %+9.1f\n", MARK_NAMES[i], us / 1000.0,
+                      ((int32_t)(us - prevUs)) / 1000.0);
+        prevUs = us;
+    }
+}
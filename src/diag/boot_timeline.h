@@ -0,0 +1,43 @@
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <stdint.h>
+
+/**
+ * Boot timeline: when each startup milestone was first reached, from
+ * app start (esp_timer zero; ROM and bootloader time come before it) to
+ * the first measured pressure on the panel.
+ *
+ * boot_mark() is a single store and may be called from any task; only
+ * the first call per milestone counts. The timeline is printed once it
+ * is complete (or after BOOT_TIMELINE_TIMEOUT_MS, e.g. with the load
+ * cell unplugged) and by the "boot" console command.
+ */
+
+enum class BootMark : uint8_t {
+    SETUP,               // setup() entered
+    TASKS_STARTED,       // setup() done, every task created
+    DISPLAY_READY,       // UI task: TFT + LVGL initialized
+    MAIN_SCREEN,         // UI task: main screen built, calibrating overlay drawn
+    LOADCELL_READY,      // Sensor task: loadcell_init() (settle + tare) done
+    FIRST_SAMPLE,        // Sensor task: first conversion pushed to the logic task
+    PRESSURE_PUBLISHED,  // Logic task: first snapshot that includes a measured pressure
+    PRESSURE_SHOWN,      // UI task: that snapshot rendered, overlay gone
+    COUNT
+};
+
+/** Record a milestone (first call wins) */
+void boot_mark(BootMark mark);
+
+/** True once the milestone has been recorded */
+bool boot_reached(BootMark mark);
+
+/** Register the "boot" console command */
+void boot_timeline_init();
+
+/** Call from loop(): prints the timeline once it is complete */
+void boot_timeline_poll();
+
+void boot_timeline_print();
+
+#endif /* BOOT_TIMELINE_H */
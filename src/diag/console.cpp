@@ -0,0 +1,77 @@
+#include "console.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+#define CONSOLE_MAX_COMMANDS 16
+#define CONSOLE_LINE_MAX     64
+
+struct ConsoleCommand {
+    const char    *name;
+    const char    *help;
+    ConsoleHandler handler;
+};
+
+static void cmd_help(const char *args);
+
+static ConsoleCommand commands[CONSOLE_MAX_COMMANDS] = {
+    { "help", "List commands", cmd_help },
+};
+static int commandCount = 1;
+
+static char   line[CONSOLE_LINE_MAX];
+static size_t lineLen = 0;
+
+/* ── Built-in commands ───────────────────────────────────── */
+
+static void cmd_help(const char *args)
+{
+    for (int i = 0; i < commandCount; i++) {
+        Serial.printf("  %-10s %s\n", commands[i].name, commands[i].help);
+    }
+}
+
+/* ── Dispatch ────────────────────────────────────────────── */
+
+static void run_line(char *text)
+{
+    while (*text == ' ') text++;
+    if (*text == '\0') return;
+
+    char *args = text;
+    while (*args && *args != ' ') args++;
+    if (*args) *args++ = '\0';
+    while (*args == ' ') args++;
+
+    for (int i = 0; i < commandCount; i++) {
+        if (strcmp(commands[i].name, text) == 0) {
+            commands[i].handler(args);
+            return;
+        }
+    }
+    Serial.printf("unknown command '%s' (try 'help')\n", text);
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+void console_register(const char *name, const char *help, ConsoleHandler handler)
+{
+    if (commandCount < CONSOLE_MAX_COMMANDS) {
+        commands[commandCount++] = { name, help, handler };
+    }
+}
+
+void console_poll()
+{
+    while (Serial.available() > 0) {
+        char c = (char)Serial.read();
+
+        if (c == '\r' || c == '\n') {
+            line[lineLen] = '\0';
+            lineLen = 0;
+            run_line(line);
+        } else if (lineLen < CONSOLE_LINE_MAX - 1) {
+            line[lineLen++] = c;
+        }
+    }
+}
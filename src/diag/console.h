@@ -0,0 +1,30 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+/**
+ * Line-based serial console for diagnostics.
+ *
+ * Modules register commands at startup; console_poll() (called from
+ * loop()) collects input without blocking and runs a command when a
+ * full line has arrived. "help" lists every command.
+ */
+
+/**
+ * Command handler.
+ * @param args  Text after the command name (leading spaces stripped, may be "")
+ */
+typedef void (*ConsoleHandler)(const char *args);
+
+/**
+ * Register a command (call before the first console_poll()).
+ * @param name  Command word; the string must outlive the console
+ * @param help  One-line description shown by "help"
+ */
+void console_register(const char *name, const char *help, ConsoleHandler handler);
+
+/**
+ * Read pending serial input and run any complete command line.
+ */
+void console_poll();
+
+#endif /* CONSOLE_H */
@@ -0,0 +1,102 @@
+#include "mem_report.h"
+#include "console.h"
+#include "../config.h"
+#include "../display/lv_setup.h"
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+#define MEM_MAX_TASKS 8
+
+struct TaskEntry {
+    const char  *name;
+    TaskHandle_t handle;
+    uint32_t     stackBytes;
+};
+
+static TaskEntry tasks[MEM_MAX_TASKS];
+static int       taskCount   = 0;
+static bool      bootPrinted = MEM_REPORT_BOOT_MS == 0;
+
+static uint32_t frag_pct(uint32_t freeBytes, uint32_t largest)
+{
+    return freeBytes ? 100 - (uint32_t)((uint64_t)largest * 100 / freeBytes) : 0;
+}
+
+static void print_heap(const char *name, uint32_t caps)
+{
+    size_t total = heap_caps_get_total_size(caps);
+    if (total == 0) return;   /* e.g. no PSRAM on this board */
+
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, caps);
+    Serial.printf("%-10s %8u %8u %8u %8u %5u%%\n", name, (unsigned)total,
+                  (unsigned)info.total_free_bytes, (unsigned)info.minimum_free_bytes,
+                  (unsigned)info.largest_free_block,
+                  (unsigned)frag_pct(info.total_free_bytes, info.largest_free_block));
+}
+
+/* ── Console ─────────────────────────────────────────────── */
+
+static void cmd_mem(const char *args)
+{
+    mem_report_print();
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+void mem_report_init()
+{
+    console_register("mem", "Heap, LVGL pool and task stack usage", cmd_mem);
+}
+
+void mem_report_register_task(const char *name, TaskHandle_t task, uint32_t stackBytes)
+{
+    if (task && taskCount < MEM_MAX_TASKS) {
+        tasks[taskCount++] = { name, task, stackBytes };
+    }
+}
+
+void mem_report_poll()
+{
+    if (!bootPrinted && millis() >= MEM_REPORT_BOOT_MS) {
+        bootPrinted = true;
+        mem_report_print();
+    }
+}
+
+void mem_report_print_stacks()
+{
+    Serial.printf("%-10s %8s %8s %8s\n", "task", "stack", "max used", "free");
+    for (int i = 0; i < taskCount; i++) {
+        /* ESP-IDF reports the high-water mark in bytes */
+        uint32_t freeBytes = uxTaskGetStackHighWaterMark(tasks[i].handle);
+        Serial.printf("%-10s %8u %8u %8u\n", tasks[i].name, (unsigned)tasks[i].stackBytes,
+                      (unsigned)(tasks[i].stackBytes - freeBytes), (unsigned)freeBytes);
+    }
+}
+
+void mem_report_print()
+{
+    Serial.printf("%-10s %8s %8s %8s %8s %6s\n",
+                  "heap", "size", "free", "min free", "largest", "frag");
+    print_heap("internal", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    print_heap("dma", MALLOC_CAP_DMA);
+    print_heap("psram", MALLOC_CAP_SPIRAM);
+
+    LvMemStats lv;
+    lv_setup_get_mem_stats(lv);
+    Serial.printf("lvgl pool: size=%u used=%u peak=%u largest=%u frag=%u%%\n",
+                  (unsigned)lv.total, (unsigned)lv.used, (unsigned)lv.maxUsed,
+                  (unsigned)lv.biggestFree, (unsigned)lv.fragPct);
+
+    FrameStats fs;
+    lv_setup_get_frame_stats(fs);
+    Serial.printf("draw buffers: %u x %u lines = %u bytes (%s)\n",
+                  (unsigned)fs.bufCount, (unsigned)fs.bufLines,
+                  (unsigned)(fs.bufCount * SCREEN_WIDTH * fs.bufLines * sizeof(lv_color_t)),
+                  DISPLAY_BUF_PSRAM ? "psram" : "dma");
+
+    Serial.printf("rtos objects: %s\n", RTOS_STATIC_ALLOC ? "static (.bss)" : "heap");
+    mem_report_print_stacks();
+}
@@ -0,0 +1,39 @@
+#ifndef MEM_REPORT_H
+#define MEM_REPORT_H
+
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * RAM usage report, for sizing LV_MEM_SIZE_KB, the task stacks and the
+ * draw buffers from measurements instead of guesses.
+ *
+ *   - Heaps (internal, DMA-capable, PSRAM): free now, lowest free since
+ *     boot, largest free block and fragmentation (1 − largest / free).
+ *   - LVGL's pool: used, peak and fragmentation (lv_setup_get_mem_stats).
+ *   - Every registered task: stack size, peak use and headroom.
+ *
+ * Printed once MEM_REPORT_BOOT_MS after boot and by the "mem" console
+ * command.
+ */
+
+/** Register the "mem" console command */
+void mem_report_init();
+
+/**
+ * Include a task in the stack report.
+ * @param stackBytes  Stack size the task was created with
+ */
+void mem_report_register_task(const char *name, TaskHandle_t task, uint32_t stackBytes);
+
+/** Call from loop(): prints the boot report when it is due */
+void mem_report_poll();
+
+/** Print the full report over the serial console */
+void mem_report_print();
+
+/** Print only the task stack table (also part of the profiler report) */
+void mem_report_print_stacks();
+
+#endif /* MEM_REPORT_H */
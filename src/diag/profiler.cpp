@@ -0,0 +1,209 @@
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+
+#include <Arduino.h>
+#include <string.h>
+
+#ifndef HEATPRESS_NATIVE
+#include <stdlib.h>
+#include "console.h"
+#include "mem_report.h"
+#endif
+
+/* ── Histogram ───────────────────────────────────────────── */
+
+/* Values 0..3 get a bucket each; above that every power of two is split
+ * into four sub-buckets: [4,5) [5,6) [6,7) [7,8) [8,10) ... */
+static const int BUCKETS = 4 * 31;
+
+struct ProbeStats {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t hist[BUCKETS];
+};
+
+static int bucket_of(uint32_t v)
+{
+    if (v < 4) return (int)v;
+    int msb = 31 - __builtin_clz(v);
+    return 4 * (msb - 1) + (int)((v >> (msb - 2)) & 3);
+}
+
+/* Largest value that falls in bucket i */
+static uint32_t bucket_upper(int i)
+{
+    if (i < 4) return (uint32_t)i;
+    int      msb   = i / 4 + 1;
+    uint64_t lower = (uint64_t)(4 + i % 4) << (msb - 2);
+    return (uint32_t)(lower + (1ULL << (msb - 2)) - 1);
+}
+
+/* ── State ───────────────────────────────────────────────── */
+
+static const char *const PROBE_NAMES[(int)ProfProbe::COUNT] = {
+    "ui_handle_command",
+    "lv_timer_handler",
+    "tft_flush_cb",
+    "loadcell_read",
+    "PressTimer::tick",
+};
+
+static const char *const LATENCY_NAMES[(int)ProfLatency::COUNT] = {
+    "sample->state",
+    "alert lateness",
+};
+
+static const char *const QUEUE_NAMES[(int)ProfQueue::COUNT] = {
+    "actionQueue",
+    "sensorRing",
+};
+
+struct QueueStats {
+    uint32_t samples;
+    uint32_t last;
+    uint32_t max;
+    uint64_t total;
+};
+
+static ProbeStats probes[(int)ProfProbe::COUNT];
+static ProbeStats latencies[(int)ProfLatency::COUNT];
+static QueueStats queues[(int)ProfQueue::COUNT];
+
+#ifndef HEATPRESS_NATIVE
+static uint32_t streamMs     = PROFILER_STREAM_MS;
+static uint32_t lastStreamMs = 0;
+#endif
+
+/* ── Recording ───────────────────────────────────────────── */
+
+static void add_sample(ProbeStats &p, uint32_t v)
+{
+    if (p.count == 0 || v < p.min) p.min = v;
+    if (v > p.max) p.max = v;
+    p.count++;
+    p.total += v;
+    p.hist[bucket_of(v)]++;
+}
+
+void profiler_record(ProfProbe probe, uint32_t cycles)
+{
+    add_sample(probes[(int)probe], cycles);
+}
+
+void profiler_latency(ProfLatency which, uint32_t us)
+{
+    add_sample(latencies[(int)which], us);
+}
+
+void profiler_depth(ProfQueue queue, uint32_t depth)
+{
+    QueueStats &q = queues[(int)queue];
+    q.samples++;
+    q.last   = depth;
+    q.total += depth;
+    if (depth > q.max) q.max = depth;
+}
+
+/* ── Reporting ───────────────────────────────────────────── */
+
+static uint32_t percentile(const ProbeStats &p, uint32_t pct)
+{
+    uint64_t target = ((uint64_t)p.count * pct + 99) / 100;
+    uint64_t seen   = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += p.hist[i];
+        if (seen >= target) {
+            uint32_t upper = bucket_upper(i);
+            return upper < p.max ? upper : p.max;
+        }
+    }
+    return p.max;
+}
+
+static void print_row(const char *name, ProbeStats p, double perUs)
+{
+    if (p.count == 0) {
+        Serial.printf("%-18s %8u %9s %9s %9s %9s\n", name, 0u, "-", "-", "-", "-");
+        return;
+    }
+    Serial.printf("%-18s %8u %9.1f %9.1f %9.1f %9.1f\n", name, (unsigned)p.count,
+                  p.min / perUs, (double)p.total / p.count / perUs,
+                  p.max / perUs, percentile(p, 99) / perUs);
+}
+
+void profiler_report()
+{
+#ifdef HEATPRESS_NATIVE
+    const double cyclesPerUs = 1000.0;
+#else
+    const double cyclesPerUs = (double)getCpuFrequencyMhz();
+#endif
+
+    Serial.printf("%-18s %8s %9s %9s %9s %9s  (us)\n", "probe", "count", "min", "avg", "max", "p99");
+    for (int i = 0; i < (int)ProfProbe::COUNT; i++) {
+        print_row(PROBE_NAMES[i], probes[i], cyclesPerUs);
+    }
+
+    Serial.printf("%-18s %8s %9s %9s %9s %9s  (us)\n", "latency", "count", "min", "avg", "max", "p99");
+    for (int i = 0; i < (int)ProfLatency::COUNT; i++) {
+        print_row(LATENCY_NAMES[i], latencies[i], 1.0);
+    }
+
+    Serial.printf("%-18s %8s %9s %9s %9s\n", "queue", "samples", "last", "avg", "max");
+    for (int i = 0; i < (int)ProfQueue::COUNT; i++) {
+        const QueueStats &q = queues[i];
+        Serial.printf("%-18s %8u %9u %9.2f %9u\n", QUEUE_NAMES[i], (unsigned)q.samples,
+                      (unsigned)q.last, q.samples ? (double)q.total / q.samples : 0.0,
+                      (unsigned)q.max);
+    }
+
+#ifndef HEATPRESS_NATIVE
+    mem_report_print_stacks();
+#endif
+}
+
+void profiler_reset()
+{
+    memset(probes, 0, sizeof(probes));
+    memset(latencies, 0, sizeof(latencies));
+    memset(queues, 0, sizeof(queues));
+}
+
+/* ── Console ─────────────────────────────────────────────── */
+
+#ifndef HEATPRESS_NATIVE
+static void cmd_prof(const char *args)
+{
+    if (*args == '\0') {
+        profiler_report();
+    } else if (strcmp(args, "reset") == 0) {
+        profiler_reset();
+    } else if (strncmp(args, "stream", 6) == 0) {
+        streamMs     = (uint32_t)strtoul(args + 6, nullptr, 10);
+        lastStreamMs = millis();
+    } else {
+        Serial.println("usage: prof [reset | stream <ms, 0=off>]");
+    }
+}
+
+void profiler_init()
+{
+    console_register("prof", "Profiler report [reset | stream <ms>]", cmd_prof);
+}
+
+void profiler_poll()
+{
+    if (streamMs == 0) return;
+
+    uint32_t now = millis();
+    if (now - lastStreamMs >= streamMs) {
+        lastStreamMs = now;
+        profiler_report();
+    }
+}
+#endif
+
+#endif /* PROFILER_ENABLED */
@@ -0,0 +1,117 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * Lightweight runtime profiler.
+ *
+ * PROF_SCOPE(PROBE) times the rest of the enclosing scope with the CPU
+ * cycle counter and adds the result to that probe's histogram (log-linear
+ * buckets, ~19% resolution, so min/avg/max are exact and p99 is the upper
+ * edge of its bucket). PROF_DEPTH() records a queue fill level as seen by
+ * its consumer. PROF_LATENCY() adds an end-to-end delay measured in µs
+ * between two tasks (e.g. conversion time → state change) to the
+ * same kind of histogram. The report ends with the task stack table
+ * from mem_report.h.
+ *
+ * With PROFILER_ENABLED 0 the macros expand to nothing and this module
+ * compiles to an empty translation unit.
+ *
+ * Each probe / queue must be written by one task only; reports read the
+ * counters without locking, so a report may be off by the sample being
+ * recorded at that moment.
+ */
+
+/* Timed code paths */
+enum class ProfProbe : uint8_t {
+    UI_HANDLE_COMMAND,
+    LV_TIMER_HANDLER,
+    TFT_FLUSH,
+    LOADCELL_READ,
+    PRESS_TIMER_TICK,
+    COUNT
+};
+
+/* Cross-task delays, in µs */
+enum class ProfLatency : uint8_t {
+    SAMPLE_TO_STATE,    // HX711 conversion → state change decided by PressTimer
+    ALERT_LATENESS,     // Alert deadline → ALERT entered by PressTimer::tick()
+    COUNT
+};
+
+/* Channels whose depth is sampled by their consumer */
+enum class ProfQueue : uint8_t {
+    ACTION_QUEUE,
+    SENSOR_RING,
+    COUNT
+};
+
+#if PROFILER_ENABLED
+
+#ifdef HEATPRESS_NATIVE
+#include <time.h>
+/* Host: nanoseconds stand in for cycles */
+static inline uint32_t prof_cycles()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+#else
+#include <Esp.h>
+static inline uint32_t prof_cycles() { return ESP.getCycleCount(); }
+#endif
+
+void profiler_record(ProfProbe probe, uint32_t cycles);
+void profiler_depth(ProfQueue queue, uint32_t depth);
+void profiler_latency(ProfLatency which, uint32_t us);
+
+class ProfScope {
+public:
+    explicit ProfScope(ProfProbe probe) : probe_(probe), start_(prof_cycles()) {}
+    ~ProfScope() { profiler_record(probe_, prof_cycles() - start_); }
+
+private:
+    ProfProbe probe_;
+    uint32_t  start_;
+};
+
+#define PROF_SCOPE(probe)         ProfScope profScope_(ProfProbe::probe)
+#define PROF_DEPTH(queue, depth)  profiler_depth(ProfQueue::queue, (uint32_t)(depth))
+#define PROF_LATENCY(which, us)   profiler_latency(ProfLatency::which, (uint32_t)(us))
+
+#ifndef HEATPRESS_NATIVE
+/**
+ * Register the "prof" console command (report / reset / stream).
+ */
+void profiler_init();
+
+/**
+ * Call from loop(): prints the report every PROFILER_STREAM_MS (or the
+ * period set with "prof stream <ms>"), if streaming is on.
+ */
+void profiler_poll();
+#endif
+
+/**
+ * Print every probe, queue and task stack over the serial console.
+ */
+void profiler_report();
+
+/**
+ * Clear probe histograms and queue statistics (stack marks are
+ * kept by FreeRTOS and can't be reset).
+ */
+void profiler_reset();
+
+#else
+
+#define PROF_SCOPE(probe)         ((void)0)
+#define PROF_DEPTH(queue, depth)  ((void)0)
+#define PROF_LATENCY(which, us)   ((void)0)
+
+#endif /* PROFILER_ENABLED */
+
+#endif /* PROFILER_H */
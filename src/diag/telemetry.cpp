@@ -0,0 +1,80 @@
+#include "telemetry.h"
+#include "console.h"
+#include "../config.h"
+#include "../util/spsc_ring.h"
+#include "../util/rtos_storage.h"
+#include "mem_report.h"
+
+#include <Arduino.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static SpscRing<TelemetrySample, TELEMETRY_RING_SIZE> ring;   // logic → telemetry task
+static TaskStorage<TELEMETRY_TASK_STACK_SIZE>         taskStorage;
+
+static volatile bool enabled = TELEMETRY_DEFAULT_ON;
+static uint16_t      seq     = 0;
+
+/* ── Writer task ─────────────────────────────────────────── */
+
+static void telemetryTask(void *pvParam)
+{
+    /* One UART write per batch of frames */
+    static uint8_t out[TELEMETRY_BATCH_SIZE * TELEMETRY_FRAME_MAX];
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(TELEMETRY_FLUSH_MS));
+
+        TelemetrySample batch[TELEMETRY_BATCH_SIZE];
+        size_t n;
+        while ((n = ring.popBatch(batch, TELEMETRY_BATCH_SIZE)) > 0) {
+            uint16_t dropped = (uint16_t)ring.dropped();
+            size_t   len     = 0;
+            for (size_t i = 0; i < n; i++) {
+                len += telemetry_encode_sample(batch[i], seq++, dropped, out + len);
+            }
+            /* May block on a full UART FIFO; only this task waits */
+            Serial.write(out, len);
+        }
+    }
+}
+
+/* ── Console ─────────────────────────────────────────────── */
+
+static void cmd_telem(const char *args)
+{
+    if (strcmp(args, "on") == 0) {
+        telemetry_enable(true);
+    } else if (strcmp(args, "off") == 0) {
+        telemetry_enable(false);
+    } else {
+        Serial.printf("telemetry %s, %u dropped\n",
+                      enabled ? "on" : "off", (unsigned)ring.dropped());
+    }
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+void telemetry_init()
+{
+    console_register("telem", "Binary sample stream [on | off]", cmd_telem);
+
+    TaskHandle_t task = nullptr;
+    taskStorage.create(
+        telemetryTask, "Telemetry", nullptr,
+        TELEMETRY_TASK_PRIORITY, &task, TELEMETRY_TASK_CORE);
+    mem_report_register_task("Telemetry", task, TELEMETRY_TASK_STACK_SIZE);
+}
+
+void telemetry_push(const TelemetrySample &sample)
+{
+    if (enabled) {
+        ring.push(sample);
+    }
+}
+
+void telemetry_enable(bool on)
+{
+    enabled = on;
+}
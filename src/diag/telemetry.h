@@ -0,0 +1,38 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include "telemetry_frame.h"
+
+/**
+ * Binary sample telemetry over Serial (format: telemetry_frame.h).
+ *
+ * The logic task hands every processed sample to telemetry_push(), which
+ * only copies it into a lock-free ring. A low-priority task drains the
+ * ring, frames the samples and writes them to the UART, so neither the
+ * sensor nor the logic path ever waits on the serial port. When the ring
+ * is full (UART slower than the ADC) samples are dropped and counted;
+ * the count travels in every frame.
+ *
+ * Off at boot unless TELEMETRY_DEFAULT_ON; toggled with the "telem"
+ * console command. Text written by the console while streaming only
+ * corrupts the frame it lands in.
+ */
+
+/**
+ * Create the telemetry task and register the "telem" console command.
+ */
+void telemetry_init();
+
+/**
+ * Queue one sample (logic task only, never blocks).
+ * No-op while streaming is off.
+ */
+void telemetry_push(const TelemetrySample &sample);
+
+/**
+ * Turn streaming on/off (any task).
+ */
+void telemetry_enable(bool on);
+
+#endif /* TELEMETRY_H */
@@ -0,0 +1,58 @@
+#include "telemetry_frame.h"
+#include "../util/crc16.h"
+
+size_t telemetry_cobs_encode(const uint8_t *data, size_t len, uint8_t *out)
+{
+    size_t  codeIdx = 0;   /* where the current block's length byte goes */
+    size_t  o       = 1;
+    uint8_t code    = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == 0) {
+            out[codeIdx] = code;
+            codeIdx = o++;
+            code    = 1;
+        } else {
+            out[o++] = data[i];
+            code++;
+        }
+    }
+    out[codeIdx] = code;
+    out[o++]     = 0x00;
+    return o;
+}
+
+static uint8_t *put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+size_t telemetry_encode_sample(const TelemetrySample &s, uint16_t seq, uint16_t dropped,
+                               uint8_t *out)
+{
+    uint8_t  buf[TELEMETRY_SAMPLE_PAYLOAD + 2];
+    uint8_t *p = buf;
+
+    *p++ = TELEMETRY_TYPE_SAMPLE;
+    *p++ = s.state;
+    p = put_u16(p, seq);
+    p = put_u32(p, s.timestampUs);
+    p = put_u32(p, (uint32_t)s.rawCounts);
+    p = put_u32(p, (uint32_t)s.unfiltered);
+    p = put_u32(p, (uint32_t)s.filtered);
+    p = put_u16(p, dropped);
+    p = put_u16(p, crc16_ccitt(buf, TELEMETRY_SAMPLE_PAYLOAD));
+
+    return telemetry_cobs_encode(buf, sizeof(buf), out);
+}
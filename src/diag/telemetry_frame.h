@@ -0,0 +1,56 @@
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../logic/pressure.h"
+
+/**
+ * Telemetry wire format (decoded by tools/telemetry_decode.py).
+ *
+ * Each frame is COBS(payload ‖ crc16) followed by a 0x00 delimiter, so a
+ * reader can resynchronize on any zero byte and text that slips into the
+ * stream costs at most one frame. crc16 is CRC-16/CCITT-FALSE (poly
+ * 0x1021, init 0xFFFF) over the payload, little-endian.
+ *
+ * Sample payload (TELEMETRY_TYPE_SAMPLE, 22 bytes, little-endian):
+ *   u8  type        u8  state (AppState)   u16 seq
+ *   u32 timestampUs (DRDY edge, esp_timer µs)
+ *   i32 rawCounts   (HX711 counts, see below)
+ *   i32 unfiltered  (centigrams, tared)    i32 filtered (centigrams)
+ *
+ * rawCounts is not a single conversion: HX711_ADC drops the highest and
+ * lowest of IGN_HIGH_SAMPLE + IGN_LOW_SAMPLE + samplesInUse conversions
+ * (1 + 1 + LOADCELL_SAMPLES in its default config), so with one sample in
+ * use it is the median of the last 3. A lone spike never shows up in it.
+ *   u16 dropped     (samples lost on the device so far, wraps)
+ */
+
+#define TELEMETRY_TYPE_SAMPLE     0x01
+#define TELEMETRY_SAMPLE_PAYLOAD  22
+#define TELEMETRY_FRAME_MAX       (TELEMETRY_SAMPLE_PAYLOAD + 2 + 1 + 1)  /* + crc, COBS code byte, delimiter */
+
+struct TelemetrySample {
+    uint32_t      timestampUs;
+    int32_t       rawCounts;
+    pressure_cg_t unfiltered;
+    pressure_cg_t filtered;
+    uint8_t       state;
+};
+
+/**
+ * COBS-encode len bytes (len < 254) and append the 0x00 delimiter.
+ * @param out  At least len + 2 bytes
+ * @return bytes written
+ */
+size_t telemetry_cobs_encode(const uint8_t *data, size_t len, uint8_t *out);
+
+/**
+ * Build a complete sample frame.
+ * @param out  At least TELEMETRY_FRAME_MAX bytes
+ * @return bytes written
+ */
+size_t telemetry_encode_sample(const TelemetrySample &s, uint16_t seq, uint16_t dropped,
+                               uint8_t *out);
+
+#endif /* TELEMETRY_FRAME_H */
@@ -1,69 +1,186 @@
 #include "lv_setup.h"
 
-#include <SPI.h>
 #include <TFT_eSPI.h>
-#include <XPT2046_Touchscreen.h>
 #include <lvgl.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "touch.h"
 #include "../config.h"
+#include "../diag/profiler.h"
+#include "../util/seqlock.h"
 
 /* ── TFT + Touch + LVGL internals ──────────────────────── */
 
 static TFT_eSPI tft = TFT_eSPI();
 
-/* XPT2046 on its own VSPI bus */
-static SPIClass touchSpi = SPIClass(VSPI);
-static XPT2046_Touchscreen ts(PIN_XPT2046_CS, PIN_XPT2046_IRQ);
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT && DISPLAY_BUF_COUNT != 1
+#error "DISPLAY_RENDER_DIRECT needs DISPLAY_BUF_COUNT 1 (LVGL 8 doesn't sync two direct buffers)"
+#endif
 
-/* Auto-calibration bounds (refined at runtime) */
-static uint16_t tsMinX = TOUCH_MIN_X, tsMaxX = TOUCH_MAX_X;
-static uint16_t tsMinY = TOUCH_MIN_Y, tsMaxY = TOUCH_MAX_Y;
+/* SPI DMA can't read PSRAM */
+#define FLUSH_DMA (DISPLAY_USE_DMA && !DISPLAY_BUF_PSRAM)
 
-/* Double-buffered: two 320×20 line buffers */
-static const uint32_t BUF_PX = SCREEN_WIDTH * 20;
-static lv_color_t buf1[BUF_PX];
-static lv_color_t buf2[BUF_PX];
+/* Draw buffers, allocated in lv_setup_init(): a full frame is too big for .bss */
+static const uint32_t BUF_LINES = DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+                                  ? DISPLAY_BUF_LINES : SCREEN_HEIGHT;
+static lv_color_t *buf1 = nullptr;
+static lv_color_t *buf2 = nullptr;
+static uint32_t    bufLines = 0;
+
+/* alloc_draw_bufs() halves the stripe down to this before giving up */
+static const uint32_t MIN_BUF_LINES = 10;
+static_assert(DISPLAY_RENDER_MODE != DISPLAY_RENDER_PARTIAL || DISPLAY_BUF_LINES >= MIN_BUF_LINES,
+              "DISPLAY_BUF_LINES below the smallest stripe alloc_draw_bufs() tries");
+
+/* Last resort if the heap can't hold even MIN_BUF_LINES: slow, but LVGL
+ * never gets a null buffer */
+static const uint32_t FALLBACK_BUF_LINES = 4;
+static lv_color_t     fallbackBuf[SCREEN_WIDTH * FALLBACK_BUF_LINES];
 
 static lv_disp_draw_buf_t draw_buf;
 static lv_disp_drv_t      disp_drv;
 static lv_indev_drv_t     indev_drv;
 
+static FrameStats          frameStats = {};   /* UI task only */
+static SeqLock<FrameStats> frameStatsOut;     /* copy of frameStats for other tasks */
+static bool                idle       = false;
+
+static SeqLock<TouchCal>   touchCal;   // written by the UI task, also read by the console
+static SeqLock<LvMemStats> memStats;   // sampled by the UI task, read by the memory report
+static uint32_t            lastMemSampleMs = 0;
+
 /* ── Display flush callback ──────────────────────────────── */
 
-static void tft_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+/* Send one rectangle of a buffer whose rows are `stride` pixels apart */
+static void push_area(const lv_area_t &a, const lv_color_t *src, uint32_t stride)
 {
-    uint32_t w = (area->x2 - area->x1 + 1);
-    uint32_t h = (area->y2 - area->y1 + 1);
+    uint32_t w = (a.x2 - a.x1 + 1);
+    uint32_t h = (a.y2 - a.y1 + 1);
 
+#if FLUSH_DMA
+    if (stride == w) {
+        /* Waits for the previous transfer, queues this one and returns */
+        tft.pushImageDMA(a.x1, a.y1, w, h, (uint16_t *)src);
+    } else {
+        tft.dmaWait();
+        tft.setAddrWindow(a.x1, a.y1, w, h);
+        for (uint32_t y = 0; y < h; y++) {
+            tft.pushPixelsDMA((uint16_t *)src + y * stride, w);
+        }
+    }
+#else
     tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    tft.pushColors((uint16_t *)color_p, w * h, false);
+    tft.setAddrWindow(a.x1, a.y1, w, h);
+    if (stride == w) {
+        tft.pushColors((uint16_t *)src, w * h, false);
+    } else {
+        for (uint32_t y = 0; y < h; y++) {
+            tft.pushColors((uint16_t *)src + y * stride, w, false);
+        }
+    }
     tft.endWrite();
+#endif
 
-    lv_disp_flush_ready(drv);
+    frameStats.flushes++;
+    frameStats.flushedPx += w * h;
 }
 
-/* ── Touch read callback (XPT2046) ───────────────────────── */
+static void tft_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    PROF_SCOPE(TFT_FLUSH);
+    int64_t start = esp_timer_get_time();
 
-static void touch_read_cb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+    if (drv->direct_mode) {
+        /* LVGL rendered every dirty area in place and hands over the whole
+         * screen buffer once per area; send just those areas, once, after
+         * the last one */
+        if (lv_disp_flush_is_last(drv)) {
+            lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+            for (uint16_t i = 0; i < disp->inv_p; i++) {
+                if (disp->inv_area_joined[i]) continue;
+                const lv_area_t &a = disp->inv_areas[i];
+                push_area(a, color_p + a.y1 * SCREEN_WIDTH + a.x1, SCREEN_WIDTH);
+            }
+        }
+    } else {
+        push_area(*area, color_p, area->x2 - area->x1 + 1);
+    }
+
+#if FLUSH_DMA
+    /* With two buffers reporting ready while the DMA runs is safe: LVGL
+     * renders the next stripe into the other one, and the next push waits
+     * for this transfer before that buffer is sent or reused. With one
+     * buffer LVGL would draw over the pixels still being sent. */
+    if (!buf2) tft.dmaWait();
+#endif
+
+    frameStats.flushBlockedUs += (uint32_t)(esp_timer_get_time() - start);
+
+    lv_disp_flush_ready(drv);
+}
+
+/* Called by LVGL after each refresh cycle that drew something */
+static void frame_monitor_cb(lv_disp_drv_t *drv, uint32_t timeMs, uint32_t px)
 {
-    if (ts.touched()) {
-        TS_Point p = ts.getPoint();
+    frameStats.frames++;
+    frameStats.lastFrameMs   = timeMs;
+    frameStats.totalFrameMs += timeMs;
+    if (timeMs > frameStats.maxFrameMs) frameStats.maxFrameMs = timeMs;
+    frameStatsOut.write(frameStats);
+}
 
-        /* Auto-calibrate: widen range if touch falls outside */
-        if (p.x < tsMinX) tsMinX = p.x;
-        if (p.x > tsMaxX) tsMaxX = p.x;
-        if (p.y < tsMinY) tsMinY = p.y;
-        if (p.y > tsMaxY) tsMaxY = p.y;
+/* ── Touch read callback ─────────────────────────────────── */
 
-        /* Map raw to screen pixels */
-        data->point.x = map(p.x, tsMinX, tsMaxX, 1, SCREEN_WIDTH);
-        data->point.y = map(p.y, tsMinY, tsMaxY, 1, SCREEN_HEIGHT);
+/* The touch task did the SPI reads and filtering; just map its point */
+static void touch_read_cb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+    TouchPoint p;
+    touch_get(p);
+    if (p.pressed) {
+        TouchCal cal;
+        int16_t  x, y;
+        touchCal.read(cal);
+        touch_cal_apply(cal, p.x, p.y, x, y);
+        data->point.x = x;
+        data->point.y = y;
         data->state   = LV_INDEV_STATE_PRESSED;
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
     }
 }
 
+/* ── Draw buffers ────────────────────────────────────────── */
+
+static lv_color_t *alloc_buf(uint32_t px)
+{
+#if DISPLAY_BUF_PSRAM
+    void *p = heap_caps_malloc(px * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    if (p) return (lv_color_t *)p;
+#endif
+    return (lv_color_t *)heap_caps_malloc(px * sizeof(lv_color_t),
+                                          MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+}
+
+/* Allocate DISPLAY_BUF_COUNT buffers of BUF_LINES rows, halving the
+ * stripe until they fit (a full frame needs 150 KB per buffer, which a
+ * board without PSRAM can't provide). @return rows per buffer, 0 if not
+ * even MIN_BUF_LINES fit */
+static uint32_t alloc_draw_bufs()
+{
+    for (uint32_t lines = BUF_LINES; lines >= MIN_BUF_LINES; lines /= 2) {
+        buf1 = alloc_buf(SCREEN_WIDTH * lines);
+        buf2 = (buf1 && DISPLAY_BUF_COUNT > 1) ? alloc_buf(SCREEN_WIDTH * lines) : nullptr;
+        if (buf1 && (buf2 || DISPLAY_BUF_COUNT == 1)) return lines;
+
+        heap_caps_free(buf1);
+        heap_caps_free(buf2);
+        buf1 = buf2 = nullptr;
+    }
+    return 0;
+}
+
 /* ── Public API ───────────────────────────────────────────── */
 
 void lv_setup_init()
@@ -73,24 +190,46 @@ void lv_setup_init()
     tft.setRotation(1);  /* Landscape */
     tft.fillScreen(TFT_BLACK);
 
-    /* Initialize XPT2046 touch on VSPI */
-    touchSpi.begin(PIN_XPT2046_CLK, PIN_XPT2046_MISO,
-                   PIN_XPT2046_MOSI, PIN_XPT2046_CS);
-    ts.begin(touchSpi);
-    ts.setRotation(1);  /* Landscape, matching display rotation */
+#if FLUSH_DMA
+    /* The TFT has HSPI to itself (touch is on VSPI), so keep the bus
+     * claimed for the DMA transfers */
+    tft.initDMA();
+    tft.startWrite();
+#endif
+
+    /* XPT2046 touch on VSPI; a touch-down wakes this (the UI) task */
+    touchCal.write(touch_cal_default());
+    touch_init(xTaskGetCurrentTaskHandle());
 
     /* Initialize LVGL */
     lv_init();
 
-    /* Set up draw buffers (double-buffered for smooth rendering) */
-    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, BUF_PX);
+    /* Set up draw buffers (see DISPLAY_RENDER_MODE) */
+    bufLines = alloc_draw_bufs();
+    if (bufLines == 0) {
+        buf1     = fallbackBuf;
+        buf2     = nullptr;
+        bufLines = FALLBACK_BUF_LINES;
+        Serial.printf("display: no heap for draw buffers, using a %u-line static stripe\n",
+                      (unsigned)bufLines);
+    } else if (bufLines != BUF_LINES) {
+        Serial.printf("display: draw buffers cut to %u lines\n", (unsigned)bufLines);
+    }
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, SCREEN_WIDTH * bufLines);
+    frameStats.bufLines = bufLines;
+    frameStats.bufCount = buf2 ? 2 : 1;
+    frameStatsOut.write(frameStats);
 
     /* Display driver */
     lv_disp_drv_init(&disp_drv);
     disp_drv.hor_res  = SCREEN_WIDTH;
     disp_drv.ver_res  = SCREEN_HEIGHT;
-    disp_drv.flush_cb = tft_flush_cb;
-    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb   = tft_flush_cb;
+    disp_drv.monitor_cb = frame_monitor_cb;
+    disp_drv.draw_buf   = &draw_buf;
+    /* Screen-sized modes fall back to stripes if the full frame didn't fit */
+    disp_drv.direct_mode  = DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT && bufLines == SCREEN_HEIGHT;
+    disp_drv.full_refresh = DISPLAY_RENDER_MODE == DISPLAY_RENDER_FULL && bufLines == SCREEN_HEIGHT;
     lv_disp_drv_register(&disp_drv);
 
     /* Input (touch) driver */
@@ -100,7 +239,75 @@ void lv_setup_init()
     lv_indev_drv_register(&indev_drv);
 }
 
-void lv_setup_update()
+/* lv_mem_monitor() walks the pool, so only the UI task may call it */
+static void sample_mem()
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    LvMemStats st = { mon.total_size, mon.total_size - mon.free_size, mon.max_used,
+                      mon.free_biggest_size, mon.frag_pct };
+    memStats.write(st);
+}
+
+uint32_t lv_setup_update()
+{
+    uint32_t next;
+    {
+        PROF_SCOPE(LV_TIMER_HANDLER);
+        next = lv_timer_handler();
+    }
+
+    if (millis() - lastMemSampleMs >= MEM_REPORT_LV_SAMPLE_MS) {
+        lastMemSampleMs = millis();
+        sample_mem();
+    }
+    return next;
+}
+
+void lv_setup_set_idle(bool enable)
+{
+    if (enable == idle) return;
+    idle = enable;
+
+    if (enable) {
+        lv_timer_pause(indev_drv.read_timer);
+    } else {
+        lv_timer_resume(indev_drv.read_timer);
+        lv_timer_ready(indev_drv.read_timer);  /* read the touch on this run */
+    }
+}
+
+bool lv_setup_touch_active()
+{
+    return touch_pressed() ||
+           lv_disp_get_inactive_time(nullptr) < UI_TOUCH_HOLD_MS;
+}
+
+void lv_setup_set_touch_cal(const TouchCal &cal)
+{
+    touchCal.write(cal);
+}
+
+void lv_setup_get_touch_cal(TouchCal &cal)
+{
+    if (!touchCal.read(cal)) cal = touch_cal_default();
+}
+
+bool lv_setup_touch_raw(uint16_t &x, uint16_t &y)
+{
+    TouchPoint p;
+    touch_get(p);
+    x = p.x;
+    y = p.y;
+    return p.pressed;
+}
+
+void lv_setup_get_frame_stats(FrameStats &stats)
+{
+    if (!frameStatsOut.read(stats)) stats = FrameStats{};
+}
+
+void lv_setup_get_mem_stats(LvMemStats &stats)
 {
-    lv_timer_handler();
+    if (!memStats.read(stats)) stats = LvMemStats{};
 }
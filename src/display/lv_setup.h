@@ -2,6 +2,35 @@
 #define LV_SETUP_H
 
 #include <lvgl.h>
+#include <stdint.h>
+#include "touch_cal.h"
+
+/**
+ * Frame timing counters (cumulative since boot).
+ */
+struct FrameStats {
+    uint32_t frames;          // Refresh cycles that redrew something
+    uint32_t flushes;         // Rectangles sent to the panel (one per stripe, or per dirty area in DIRECT)
+    uint32_t flushedPx;       // Pixels sent to the panel
+    uint32_t lastFrameMs;     // Render + flush time of the last frame
+    uint32_t maxFrameMs;
+    uint32_t totalFrameMs;    // totalFrameMs / frames = average
+    uint32_t flushBlockedUs;  // Time the UI task spent blocked inside flush_cb
+    uint32_t bufLines;        // Draw buffer rows actually allocated (DISPLAY_BUF_LINES may not fit)
+    uint32_t bufCount;        // Draw buffers in use (1 on the static fallback stripe)
+};
+
+/**
+ * LVGL's own heap (LV_MEM_SIZE), sampled by the UI task every
+ * MEM_REPORT_LV_SAMPLE_MS.
+ */
+struct LvMemStats {
+    uint32_t total;         // LV_MEM_SIZE
+    uint32_t used;
+    uint32_t maxUsed;       // Peak since boot (tracked by LVGL on every allocation)
+    uint32_t biggestFree;   // Largest free block
+    uint32_t fragPct;
+};
 
 /**
  * Initialize LVGL, TFT display driver, and touch input driver.
@@ -11,8 +40,44 @@ void lv_setup_init();
 
 /**
  * Call periodically from the UI task to process LVGL timers/rendering.
- * Should be called every ~33ms for 30fps.
+ * Should be called every ~33ms for 30fps while anything animates.
+ * @return ms until LVGL's next timer is due (LV_NO_TIMER_READY if none)
+ */
+uint32_t lv_setup_update();
+
+/**
+ * Idle mode: stop LVGL's input polling. A touch still wakes the UI task
+ * (the touch task notifies it on touch-down).
+ */
+void lv_setup_set_idle(bool idle);
+
+/**
+ * True while the panel is touched or was touched within UI_TOUCH_HOLD_MS.
  */
-void lv_setup_update();
+bool lv_setup_touch_active();
+
+/**
+ * Replace the raw → screen touch mapping (UI task; takes effect on the
+ * next input read). Starts as touch_cal_default().
+ */
+void lv_setup_set_touch_cal(const TouchCal &cal);
+
+/** Current touch mapping (any task) */
+void lv_setup_get_touch_cal(TouchCal &cal);
+
+/**
+ * The filtered touch point before calibration, for the calibration screen.
+ * @return true while the panel is touched
+ */
+bool lv_setup_touch_raw(uint16_t &x, uint16_t &y);
+
+/**
+ * Copy the frame timing counters as of the last frame (safe from any task:
+ * published through a SeqLock, so the copy is never torn).
+ */
+void lv_setup_get_frame_stats(FrameStats &stats);
+
+/** Latest LVGL heap sample (any task; zeroes before the first frame) */
+void lv_setup_get_mem_stats(LvMemStats &stats);
 
 #endif /* LV_SETUP_H */
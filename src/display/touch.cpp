@@ -0,0 +1,172 @@
+#include "touch.h"
+#include "touch_filter.h"
+#include "../config.h"
+#include "../util/seqlock.h"
+#include "../util/rtos_storage.h"
+#include "../diag/mem_report.h"
+
+#include <Arduino.h>
+#include <SPI.h>
+
+/* XPT2046 on its own VSPI bus */
+static SPIClass touchSpi = SPIClass(VSPI);
+static const SPISettings TOUCH_SPI_SETTINGS(2000000, MSBFIRST, SPI_MODE0);
+
+/* XPT2046 control bytes: start bit, channel, 12-bit, differential.
+ * PD = 01 keeps the ADC on between conversions; PD = 00 powers it down
+ * and re-enables the pen interrupt on T_IRQ. */
+static const uint8_t CMD_X  = 0x91;
+static const uint8_t CMD_Y  = 0xD1;
+static const uint8_t CMD_Z1 = 0xB1;
+static const uint8_t CMD_Z2 = 0xC1;
+static const uint8_t CMD_Y_POWER_DOWN = 0xD0;
+
+static TaskStorage<TOUCH_TASK_STACK_SIZE> touchTaskStorage;
+static TaskHandle_t touchTask  = nullptr;
+static TaskHandle_t notifyTask = nullptr;
+
+static SeqLock<TouchPoint> point;      // touch task → LVGL read callback
+static TouchStats          stats = {};  // touch task only
+static SeqLock<TouchStats> statsOut;    // copy of stats for other tasks
+
+/* ── SPI ─────────────────────────────────────────────────── */
+
+/* Each transfer16() returns the previous command's 12-bit result in
+ * bits 14..3 while clocking out the next command */
+static uint16_t result(uint16_t word) { return word >> 3; }
+
+/* One transaction: pressure, then (if touched) TOUCH_BURST X/Y pairs.
+ * @return number of samples written to out[] (0 if not pressed hard enough) */
+static uint8_t read_burst(TouchSample out[TOUCH_BURST])
+{
+    uint8_t n = 0;
+
+    touchSpi.beginTransaction(TOUCH_SPI_SETTINGS);
+    digitalWrite(PIN_XPT2046_CS, LOW);
+
+    touchSpi.transfer(CMD_Z1);
+    int32_t z1 = result(touchSpi.transfer16(CMD_Z2));
+    int32_t z2 = result(touchSpi.transfer16(CMD_X));
+    int32_t z  = z1 + 4095 - z2;
+    if (z < 0) z = 0;
+
+    if (z >= TOUCH_Z_MIN) {
+        touchSpi.transfer16(CMD_X);   /* first X after Z is noisy: discard */
+        for (; n < TOUCH_BURST; n++) {
+            out[n].x = result(touchSpi.transfer16(CMD_Y));
+            out[n].y = result(touchSpi.transfer16(CMD_X));
+            out[n].z = (uint16_t)z;
+        }
+    }
+
+    /* Power down with the pen interrupt enabled again */
+    touchSpi.transfer16(CMD_Y_POWER_DOWN);
+    touchSpi.transfer16(0);
+
+    digitalWrite(PIN_XPT2046_CS, HIGH);
+    touchSpi.endTransaction();
+
+    stats.reads++;
+    return n;
+}
+
+/* ── Touch task ──────────────────────────────────────────── */
+
+static void publish(const TouchFilter &filter)
+{
+    TouchPoint p = {};
+    if (filter.pressed()) {
+        p.x       = filter.x();
+        p.y       = filter.y();
+        p.pressed = 1;
+    }
+    point.write(p);
+}
+
+static void touchTaskFn(void *pvParam)
+{
+    TouchFilter filter(TOUCH_MEDIAN_WINDOW, TOUCH_Z_MIN, TOUCH_IIR_ALPHA_Q8,
+                       TOUCH_RELEASE_SAMPLES);
+    TouchSample burst[TOUCH_BURST];
+    TouchSample released = { 0, 0, 0 };
+
+    for (;;) {
+        /* Our own reads make T_IRQ glitch, so a notification may be stale;
+         * the line itself says whether the panel is touched right now */
+        if (digitalRead(PIN_XPT2046_IRQ) == HIGH) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        stats.wakeups++;
+
+        TickType_t lastWake = xTaskGetTickCount();
+        do {
+            bool    was = filter.pressed();
+            uint8_t n   = read_burst(burst);
+            if (n == 0) {
+                filter.add(released);
+            }
+            for (uint8_t i = 0; i < n; i++) {
+                filter.add(burst[i]);
+            }
+
+            if (filter.pressed() || was) publish(filter);
+            if (filter.pressed() && !was) {
+                stats.touches++;
+                xTaskNotifyGive(notifyTask);   /* wake an idle UI task */
+            }
+            statsOut.write(stats);
+
+            vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(TOUCH_SAMPLE_MS));
+        } while (filter.pressed() || digitalRead(PIN_XPT2046_IRQ) == LOW);
+
+        /* Lifted before a point was reported: drop the partial window */
+        filter.reset();
+        ulTaskNotifyTake(pdTRUE, 0);
+    }
+}
+
+static void IRAM_ATTR touch_irq_isr()
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(touchTask, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+void touch_init(TaskHandle_t notify)
+{
+    notifyTask = notify;
+
+    pinMode(PIN_XPT2046_CS, OUTPUT);
+    digitalWrite(PIN_XPT2046_CS, HIGH);
+    pinMode(PIN_XPT2046_IRQ, INPUT);
+    touchSpi.begin(PIN_XPT2046_CLK, PIN_XPT2046_MISO,
+                   PIN_XPT2046_MOSI, PIN_XPT2046_CS);
+
+    point.write(TouchPoint{});
+
+    touchTaskStorage.create(
+        touchTaskFn, "Touch", nullptr,
+        TOUCH_TASK_PRIORITY, &touchTask, TOUCH_TASK_CORE);
+    mem_report_register_task("Touch", touchTask, TOUCH_TASK_STACK_SIZE);
+
+    attachInterrupt(digitalPinToInterrupt(PIN_XPT2046_IRQ), touch_irq_isr, FALLING);
+}
+
+void touch_get(TouchPoint &out)
+{
+    if (!point.read(out)) out = TouchPoint{};
+}
+
+bool touch_pressed()
+{
+    TouchPoint p;
+    touch_get(p);
+    return p.pressed;
+}
+
+void touch_get_stats(TouchStats &out)
+{
+    if (!statsOut.read(out)) out = TouchStats{};
+}
@@ -0,0 +1,50 @@
+#ifndef TOUCH_H
+#define TOUCH_H
+
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * XPT2046 touch driver, gated by the panel's T_IRQ line.
+ *
+ * While nobody touches the screen there is no SPI traffic: a task sleeps
+ * until T_IRQ falls, then reads the controller every TOUCH_SAMPLE_MS
+ * (pressure plus a burst of X/Y conversions per transaction) through a
+ * TouchFilter until the touch ends. The filtered point is published
+ * lock-free; LVGL's read callback only copies it and maps it to screen
+ * pixels (touch_cal.h).
+ */
+
+struct TouchPoint {
+    uint16_t x, y;       // Raw ADC (0..4095), filtered
+    uint8_t  pressed;
+    uint8_t  reserved[3];
+};
+
+struct TouchStats {
+    uint32_t wakeups;    // T_IRQ wakeups of the touch task
+    uint32_t reads;      // SPI transactions
+    uint32_t touches;    // Touches reported to LVGL
+};
+
+/**
+ * Start the touch task on the VSPI bus.
+ * @param notifyTask  Task notified (xTaskNotifyGive) when a touch begins,
+ *                    so an idle UI task wakes up for it
+ */
+void touch_init(TaskHandle_t notifyTask);
+
+/** Latest filtered point (any task, no SPI) */
+void touch_get(TouchPoint &out);
+
+/** True while the panel is touched */
+bool touch_pressed();
+
+/**
+ * Copy the touch task counters (safe from any task: published through a
+ * SeqLock, so the copy is never torn).
+ */
+void touch_get_stats(TouchStats &out);
+
+#endif /* TOUCH_H */
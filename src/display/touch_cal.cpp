@@ -0,0 +1,83 @@
+#include "touch_cal.h"
+#include "../config.h"
+
+#include <math.h>
+
+/* Bounds that keep every term of touch_cal_apply() inside int32 for
+ * 12-bit raw values, and that a real panel stays well within (the
+ * CYD's scale is about 0.1 px per count) */
+static const float MAX_SCALE  = 1.0f;                 /* px per raw count */
+static const float MAX_OFFSET = 4096.0f;              /* px */
+static const float Q16        = 65536.0f;
+
+static int32_t q16(float v)
+{
+    return (int32_t)lroundf(v * Q16);
+}
+
+TouchCal touch_cal_default()
+{
+    float sx = (float)(SCREEN_WIDTH - 1) / (float)(TOUCH_MAX_X - TOUCH_MIN_X);
+    float sy = (float)(SCREEN_HEIGHT - 1) / (float)(TOUCH_MAX_Y - TOUCH_MIN_Y);
+
+    TouchCal cal;
+    cal.a = q16(sx);
+    cal.b = 0;
+    cal.c = q16(1.0f - TOUCH_MIN_X * sx + 0.5f);
+    cal.d = 0;
+    cal.e = q16(sy);
+    cal.f = q16(1.0f - TOUCH_MIN_Y * sy + 0.5f);
+    return cal;
+}
+
+bool touch_cal_solve(const uint16_t raw[3][2], const int16_t screen[3][2], TouchCal &out)
+{
+    float x0 = raw[0][0], y0 = raw[0][1];
+    float x1 = raw[1][0], y1 = raw[1][1];
+    float x2 = raw[2][0], y2 = raw[2][1];
+
+    /* Twice the area of the raw triangle: targets a third of the screen
+     * apart are ~10^6 counts², a repeated or missed tap is near zero */
+    float det = x0 * (y1 - y2) + x1 * (y2 - y0) + x2 * (y0 - y1);
+    if (fabsf(det) < 1.0e4f) return false;
+
+    float coef[2][3];
+    for (int axis = 0; axis < 2; axis++) {
+        float s0 = screen[0][axis], s1 = screen[1][axis], s2 = screen[2][axis];
+
+        /* Cramer's rule for s = p·x + q·y + r through the three points */
+        float p = (s0 * (y1 - y2) + s1 * (y2 - y0) + s2 * (y0 - y1)) / det;
+        float q = (x0 * (s1 - s2) + x1 * (s2 - s0) + x2 * (s0 - s1)) / det;
+        float r = (x0 * (y1 * s2 - y2 * s1) + x1 * (y2 * s0 - y0 * s2) +
+                   x2 * (y0 * s1 - y1 * s0)) / det;
+
+        if (fabsf(p) > MAX_SCALE || fabsf(q) > MAX_SCALE || fabsf(r) > MAX_OFFSET) {
+            return false;
+        }
+        coef[axis][0] = p;
+        coef[axis][1] = q;
+        coef[axis][2] = r;
+    }
+
+    out.a = q16(coef[0][0]);
+    out.b = q16(coef[0][1]);
+    out.c = q16(coef[0][2] + 0.5f);
+    out.d = q16(coef[1][0]);
+    out.e = q16(coef[1][1]);
+    out.f = q16(coef[1][2] + 0.5f);
+    return true;
+}
+
+void touch_cal_apply(const TouchCal &cal, uint16_t rx, uint16_t ry, int16_t &sx, int16_t &sy)
+{
+    int32_t x = (cal.a * (int32_t)rx + cal.b * (int32_t)ry + cal.c) >> 16;
+    int32_t y = (cal.d * (int32_t)rx + cal.e * (int32_t)ry + cal.f) >> 16;
+
+    if (x < 0) x = 0;
+    if (x > SCREEN_WIDTH - 1) x = SCREEN_WIDTH - 1;
+    if (y < 0) y = 0;
+    if (y > SCREEN_HEIGHT - 1) y = SCREEN_HEIGHT - 1;
+
+    sx = (int16_t)x;
+    sy = (int16_t)y;
+}
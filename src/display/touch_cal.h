@@ -0,0 +1,35 @@
+#ifndef TOUCH_CAL_H
+#define TOUCH_CAL_H
+
+#include <stdint.h>
+
+/**
+ * Affine raw → screen mapping for the resistive panel:
+ *
+ *   sx = (a·rx + b·ry + c) >> 16
+ *   sy = (d·rx + e·ry + f) >> 16
+ *
+ * Coefficients are Q16 (c and f include the rounding half), so applying
+ * it is six integer multiply-adds. Three touched targets determine it
+ * exactly, which also absorbs a rotated or mirrored panel. Solving uses
+ * floats, but only once per calibration.
+ */
+struct TouchCal {
+    int32_t a, b, c;
+    int32_t d, e, f;
+};
+
+/** Mapping from the TOUCH_MIN_* / TOUCH_MAX_* bounds in config.h */
+TouchCal touch_cal_default();
+
+/**
+ * Fit the mapping through three (raw, screen) pairs.
+ * @return false if the points are (nearly) collinear or the result is
+ *         implausible for this panel (e.g. a target was missed)
+ */
+bool touch_cal_solve(const uint16_t raw[3][2], const int16_t screen[3][2], TouchCal &out);
+
+/** Map a raw point, clamped to the screen */
+void touch_cal_apply(const TouchCal &cal, uint16_t rx, uint16_t ry, int16_t &sx, int16_t &sy);
+
+#endif /* TOUCH_CAL_H */
@@ -0,0 +1,70 @@
+#include "touch_filter.h"
+
+TouchFilter::TouchFilter(uint8_t window, uint16_t zMin, uint16_t alphaQ8, uint8_t releaseSamples)
+    : window_(window)
+    , zMin_(zMin)
+    , alphaQ8_(alphaQ8)
+    , releaseSamples_(releaseSamples)
+{
+    if (window_ > TOUCH_WINDOW_MAX) window_ = TOUCH_WINDOW_MAX;
+    if (window_ < 1) window_ = 1;
+    if ((window_ & 1) == 0) window_--;
+    if (alphaQ8_ < 1)   alphaQ8_ = 1;
+    if (alphaQ8_ > 256) alphaQ8_ = 256;
+    if (releaseSamples_ < 1) releaseSamples_ = 1;
+}
+
+void TouchFilter::reset()
+{
+    pos_      = 0;
+    count_    = 0;
+    lowCount_ = 0;
+    pressed_  = false;
+}
+
+/* Insertion sort of ≤ 7 values, as in FilterChain::median() */
+static uint16_t median_of(const uint16_t *v, uint8_t n)
+{
+    uint16_t sorted[TOUCH_WINDOW_MAX];
+    for (uint8_t i = 0; i < n; i++) {
+        uint16_t x = v[i];
+        int8_t j = (int8_t)i - 1;
+        while (j >= 0 && sorted[j] > x) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = x;
+    }
+    return sorted[n / 2];
+}
+
+bool TouchFilter::add(const TouchSample &s)
+{
+    if (s.z < zMin_) {
+        if (++lowCount_ >= releaseSamples_) reset();
+        return pressed_;
+    }
+    lowCount_ = 0;
+
+    xs_[pos_] = s.x;
+    ys_[pos_] = s.y;
+    pos_ = (uint8_t)((pos_ + 1) % window_);
+    if (count_ < window_) count_++;
+
+    /* Wait for enough samples that one outlier can't be the median */
+    if (count_ < window_ / 2 + 1) return pressed_;
+
+    int32_t mx = (int32_t)median_of(xs_, count_) << 8;
+    int32_t my = (int32_t)median_of(ys_, count_) << 8;
+
+    if (!pressed_) {
+        /* Touch-down: start from the median, don't glide in from the last touch */
+        x8_      = mx;
+        y8_      = my;
+        pressed_ = true;
+    } else {
+        x8_ += ((mx - x8_) * (int32_t)alphaQ8_) >> 8;
+        y8_ += ((my - y8_) * (int32_t)alphaQ8_) >> 8;
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <stdint.h>
+
+/**
+ * Turns raw XPT2046 samples (12-bit X, Y and pressure Z) into a stable
+ * touch point.
+ *
+ *   1. Z rejection: samples below zMin count as "not touched"; the touch
+ *      only ends after `releaseSamples` of them in a row, so a light
+ *      (gloved) press that dips for one sample doesn't lift the pen.
+ *   2. Median of X and Y over the last `window` accepted samples, which
+ *      drops the single wild readings the panel produces at touch-down
+ *      and lift-off. The touch is reported once half the window is in.
+ *   3. One-pole IIR, p += α·(m − p), α in Q8, against jitter while held.
+ *
+ * Free of hardware dependencies, like sensors/filter.h.
+ */
+
+static constexpr uint8_t TOUCH_WINDOW_MAX = 7;
+
+struct TouchSample {
+    uint16_t x, y;   // Raw ADC, 0..4095
+    uint16_t z;      // Pressure, 0 = not touched
+};
+
+class TouchFilter {
+public:
+    /**
+     * @param window          Median window (odd, ≤ TOUCH_WINDOW_MAX)
+     * @param zMin            Lowest Z taken as a touch
+     * @param alphaQ8         IIR weight of each new point (256 = no smoothing)
+     * @param releaseSamples  Consecutive low-Z samples that end a touch
+     */
+    TouchFilter(uint8_t window, uint16_t zMin, uint16_t alphaQ8, uint8_t releaseSamples);
+
+    /** Feed one sample. @return true while the panel counts as pressed */
+    bool add(const TouchSample &s);
+
+    /** Forget the current touch (e.g. after an idle period) */
+    void reset();
+
+    bool     pressed() const { return pressed_; }
+    uint16_t x() const { return (uint16_t)(x8_ >> 8); }   // Valid while pressed()
+    uint16_t y() const { return (uint16_t)(y8_ >> 8); }
+
+private:
+    uint8_t  window_;
+    uint16_t zMin_;
+    uint16_t alphaQ8_;
+    uint8_t  releaseSamples_;
+
+    uint16_t xs_[TOUCH_WINDOW_MAX];
+    uint16_t ys_[TOUCH_WINDOW_MAX];
+    uint8_t  pos_      = 0;
+    uint8_t  count_    = 0;
+    uint8_t  lowCount_ = 0;
+
+    /* Smoothed point with 8 fractional bits */
+    int32_t x8_ = 0;
+    int32_t y8_ = 0;
+    bool    pressed_ = false;
+};
+
+#endif /* TOUCH_FILTER_H */
@@ -0,0 +1,45 @@
+#include "app_snapshot.h"
+
+size_t app_snapshot_diff(const AppSnapshot *prev, const AppSnapshot &next,
+                         UICommand out[APP_SNAPSHOT_MAX_CHANGES])
+{
+    size_t n = 0;
+
+    bool settingChanged = !prev || prev->timerSeconds != next.timerSeconds;
+    bool stateChanged   = !prev || prev->stateSeq != next.stateSeq;
+
+    /* TIMING entry reads the duration, so the setting goes first */
+    if (settingChanged) {
+        out[n].type         = UICommandType::UPDATE_TIMER_SETTING;
+        out[n].timerSeconds = next.timerSeconds;
+        n++;
+    }
+
+    /* Also before the state: TIMING entry starts the arc from it */
+    if (!prev || prev->timerStartUs != next.timerStartUs) {
+        out[n].type         = UICommandType::UPDATE_TIMER_START;
+        out[n].timerStartUs = next.timerStartUs;
+        n++;
+    }
+
+    if (stateChanged) {
+        out[n].type  = UICommandType::UPDATE_STATE;
+        out[n].state = next.state;
+        n++;
+    }
+
+    /* Outside a countdown the timer label shows the full duration */
+    if (settingChanged || (stateChanged && next.state == AppState::IDLE)) {
+        out[n].type         = UICommandType::UPDATE_TIMER;
+        out[n].timerSeconds = next.timerSeconds;
+        n++;
+    }
+
+    if (!prev || prev->pressure != next.pressure) {
+        out[n].type     = UICommandType::UPDATE_PRESSURE;
+        out[n].pressure = next.pressure;
+        n++;
+    }
+
+    return n;
+}
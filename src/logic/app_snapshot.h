@@ -0,0 +1,42 @@
+#ifndef APP_SNAPSHOT_H
+#define APP_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../util/seqlock.h"
+#include "app_state.h"
+
+/**
+ * Everything the UI shows about the press, published by PressTimer as
+ * one consistent snapshot (logic task → UI task, see SeqLock).
+ *
+ * The UI reads it once per frame and updates only what differs from the
+ * last snapshot it applied. New on-screen values become new fields here
+ * rather than new message types.
+ */
+struct AppSnapshot {
+    uint32_t      stateSeq;       // Incremented on every transition (catches A→B→A between reads)
+    pressure_cg_t pressure;       // Reading as displayed (changes at 0.01 kg resolution)
+    int32_t       timerSeconds;   // Configured countdown duration
+    uint32_t      timerStartUs;   // TIMING/ALERT: press onset, micros() (backdated past the engage dwell)
+    AppState      state;
+    uint8_t       reserved[3];    // Keeps the payload whole words
+};
+
+typedef SeqLock<AppSnapshot> AppSnapshotChannel;
+
+/** Upper bound on app_snapshot_diff() output */
+static constexpr size_t APP_SNAPSHOT_MAX_CHANGES = 5;
+
+/**
+ * Express the step from one applied snapshot to the next as the UI
+ * commands that reproduce it, in the order ui_handle_command() expects
+ * (timer setting, countdown start, state, timer label, pressure).
+ * @param prev  Last snapshot applied, or nullptr if none yet
+ * @return number of commands written to out
+ */
+size_t app_snapshot_diff(const AppSnapshot *prev, const AppSnapshot &next,
+                         UICommand out[APP_SNAPSHOT_MAX_CHANGES]);
+
+#endif /* APP_SNAPSHOT_H */
@@ -2,6 +2,7 @@
 #define APP_STATE_H
 
 #include <stdint.h>
+#include "pressure.h"
 
 /**
  * Application states for the heat press state machine
@@ -13,12 +14,25 @@ enum class AppState : uint8_t {
     ALERT        // Timer expired, alerting user
 };
 
+/**
+ * Sensor-side events carried alongside (or instead of) a reading
+ */
+enum class SensorEvent : uint8_t {
+    NONE,
+    TARE_DONE,    // New zero committed; readings from here on use it
+    TARE_FAILED,  // Plate moved or no conversions; previous zero kept
+};
+
 /**
  * Message sent from sensor task → logic task
  */
 struct SensorData {
-    float pressure;       // Current pressure reading in grams
-    bool  isValid;        // Whether the reading is valid
+    pressure_cg_t pressure;    // Current pressure reading in centigrams
+    uint32_t      timestampUs; // Conversion (DRDY) time, esp_timer µs
+    bool          isValid;     // Whether the reading is valid
+    int32_t       rawCounts;   // HX711 counts behind this reading, 3-conversion median (telemetry)
+    pressure_cg_t unfiltered;  // Tared reading before the filter chain (telemetry)
+    SensorEvent   event;       // Tare result, if one completed with this message
 };
 
 /**
@@ -29,14 +43,16 @@ enum class UICommandType : uint8_t {
     UPDATE_TIMER,         // Update timer display
     UPDATE_STATE,         // State transition
     UPDATE_TIMER_SETTING, // Update "Timer: Xs" setting label
+    UPDATE_TIMER_START,   // Countdown origin (press onset) for the arc and timer text
 };
 
 struct UICommand {
     UICommandType type;
     union {
-        float    pressure;          // For UPDATE_PRESSURE
-        int      timerSeconds;      // For UPDATE_TIMER / UPDATE_TIMER_SETTING
-        AppState state;             // For UPDATE_STATE
+        pressure_cg_t pressure;     // For UPDATE_PRESSURE (centigrams)
+        int           timerSeconds; // For UPDATE_TIMER / UPDATE_TIMER_SETTING
+        AppState      state;        // For UPDATE_STATE
+        uint32_t      timerStartUs; // For UPDATE_TIMER_START (micros())
     };
 };
 
@@ -54,4 +70,24 @@ struct UserAction {
     UserActionType type;
 };
 
+/**
+ * One press cycle (TIMING → [ALERT →] IDLE), reported by PressTimer when
+ * the cycle ends
+ */
+enum PressCycleFlags : uint8_t {
+    CYCLE_ALERTED      = 0x01,  // Timer ran out before the cycle ended
+    CYCLE_ACKNOWLEDGED = 0x02,  // Ended by the acknowledge button, not by release
+    CYCLE_ABORTED      = 0x04,  // Ended by a tare
+};
+
+struct PressCycle {
+    uint32_t      startMs;      // Press onset, millis() since boot
+    uint32_t      durationMs;   // Onset → end of cycle
+    uint32_t      overtimeMs;   // ALERT → end of cycle (0 if never alerted)
+    pressure_cg_t peak;         // Highest reading during the cycle
+    pressure_cg_t mean;         // Mean reading during the cycle
+    uint16_t      timerSeconds; // Timer setting the cycle ran with
+    uint8_t       flags;        // PressCycleFlags
+};
+
 #endif /* APP_STATE_H */
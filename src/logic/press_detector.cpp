@@ -0,0 +1,47 @@
+#include "press_detector.h"
+
+PressDetector::PressDetector(pressure_cg_t engageThreshold, pressure_cg_t releaseThreshold,
+                             uint32_t engageDwellUs, uint32_t releaseDwellUs)
+    : engageThreshold_(engageThreshold)
+    , releaseThreshold_(releaseThreshold)
+    , engageDwellUs_(engageDwellUs)
+    , releaseDwellUs_(releaseDwellUs)
+{
+}
+
+bool PressDetector::update(pressure_cg_t pressure, uint32_t timestampUs)
+{
+    /* Beyond the threshold that would change the current state? */
+    bool crossing = pressed_ ? (pressure < releaseThreshold_)
+                             : (pressure > engageThreshold_);
+
+    if (!crossing) {
+        if (candidate_) {
+            candidate_ = false;
+            if (pressed_) suppressedReleases_++;
+            else          suppressedEngages_++;
+        }
+        return false;
+    }
+
+    if (!candidate_) {
+        candidate_   = true;
+        candidateUs_ = timestampUs;
+    }
+
+    uint32_t dwell = pressed_ ? releaseDwellUs_ : engageDwellUs_;
+    if ((uint32_t)(timestampUs - candidateUs_) < dwell) {
+        return false;
+    }
+
+    pressed_      = !pressed_;
+    candidate_    = false;
+    transitionUs_ = candidateUs_;
+    return true;
+}
+
+void PressDetector::reset(bool pressed)
+{
+    pressed_   = pressed;
+    candidate_ = false;
+}
@@ -0,0 +1,53 @@
+#ifndef PRESS_DETECTOR_H
+#define PRESS_DETECTOR_H
+
+#include <stdint.h>
+#include "pressure.h"
+
+/**
+ * Press detection with hysteresis and minimum dwell times.
+ *
+ * Engages once the reading has stayed above the engage threshold for
+ * the engage dwell, releases once it has stayed below the (lower)
+ * release threshold for the release dwell. Excursions that end before
+ * their dwell are counted as suppressed transitions. O(1) per sample.
+ */
+class PressDetector {
+public:
+    PressDetector(pressure_cg_t engageThreshold, pressure_cg_t releaseThreshold,
+                  uint32_t engageDwellUs, uint32_t releaseDwellUs);
+
+    /**
+     * Feed one sample.
+     * @param timestampUs  Conversion time of the sample
+     * @return true if the pressed state changed on this sample
+     */
+    bool update(pressure_cg_t pressure, uint32_t timestampUs);
+
+    /** Force a state (e.g. after tare) and drop any pending candidate */
+    void reset(bool pressed = false);
+
+    bool isPressed() const { return pressed_; }
+
+    /** Timestamp of the first sample of the last confirmed transition */
+    uint32_t transitionUs() const { return transitionUs_; }
+
+    uint32_t suppressedEngages() const  { return suppressedEngages_; }
+    uint32_t suppressedReleases() const { return suppressedReleases_; }
+
+private:
+    pressure_cg_t engageThreshold_;
+    pressure_cg_t releaseThreshold_;
+    uint32_t      engageDwellUs_;
+    uint32_t      releaseDwellUs_;
+
+    bool     pressed_      = false;
+    bool     candidate_    = false;   /* crossed, waiting out the dwell */
+    uint32_t candidateUs_  = 0;
+    uint32_t transitionUs_ = 0;
+
+    uint32_t suppressedEngages_  = 0;
+    uint32_t suppressedReleases_ = 0;
+};
+
+#endif /* PRESS_DETECTOR_H */
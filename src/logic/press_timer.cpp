@@ -1,59 +1,108 @@
 #include "press_timer.h"
 #include "../config.h"
+#include "../diag/profiler.h"
 #include <Arduino.h>
-#include <math.h>
 
-PressTimer::PressTimer(QueueHandle_t uiQueue, QueueHandle_t actionQueue)
-    : uiQueue_(uiQueue)
+PressTimer::PressTimer(AppSnapshotChannel &snapshot, QueueHandle_t actionQueue)
+    : snapshot_(snapshot)
     , actionQueue_(actionQueue)
+    , detector_(PRESSURE_THRESHOLD_CG, PRESSURE_RELEASE_THRESHOLD_CG,
+                PRESS_ENGAGE_DWELL_MS * 1000UL, PRESS_RELEASE_DWELL_MS * 1000UL)
     , timerDuration_(TIMER_DEFAULT_SECONDS)
     , timerRemaining_(TIMER_DEFAULT_SECONDS)
 {
 }
 
-void PressTimer::processPressure(float pressure)
+void PressTimer::setCycleSink(CycleSink fn, void *ctx)
 {
+    cycleSink_ = fn;
+    cycleCtx_  = ctx;
+}
+
+void PressTimer::setTimerDuration(int seconds)
+{
+    if (seconds < TIMER_MIN_SECONDS) seconds = TIMER_MIN_SECONDS;
+    if (seconds > TIMER_MAX_SECONDS) seconds = TIMER_MAX_SECONDS;
+    timerDuration_ = seconds;
+
+    if (state_ != AppState::TIMING && state_ != AppState::ALERT) {
+        timerRemaining_ = seconds;
+    }
+    dirty_ = true;
+}
+
+void PressTimer::processPressure(pressure_cg_t pressure, uint32_t timestampUs)
+{
+    /* Readings queued before the tare took effect are relative to the
+     * old zero; the sensor task reports when the new one is in place */
+    if (state_ == AppState::CALIBRATING) return;
+
     currentPressure_ = pressure;
 
-    /* Only send pressure to UI if the displayed value (2 decimal kg) changed.
-     * Use roundf() to match snprintf("%.2f") rounding behaviour. */
-    int displayVal = (int)roundf(pressure / 10.0f); /* 0.01 kg resolution */
+    /* Only republish pressure if the displayed value (2 decimal kg) changed */
+    int32_t displayVal = pressure_to_centikg(pressure); /* 0.01 kg resolution */
     if (displayVal != lastDisplayPressure_) {
         lastDisplayPressure_ = displayVal;
-        UICommand cmd;
-        cmd.type     = UICommandType::UPDATE_PRESSURE;
-        cmd.pressure = pressure;
-        sendUICommand(cmd);
+        displayPressure_     = pressure;
+        dirty_               = true;
     }
 
-    bool aboveThreshold = (pressure > PRESSURE_THRESHOLD);
+    /* Hysteresis + dwell: noise around the threshold never reaches the
+     * state machine (and so never reaches the UI queue) */
+    bool     edge    = detector_.update(pressure, timestampUs);
+    bool     pressed = detector_.isPressed();
+    AppState before  = state_;
+
+    if (state_ == AppState::TIMING || state_ == AppState::ALERT) {
+        cycleSum_ += pressure;
+        cycleSamples_++;
+        if (pressure > cyclePeak_) cyclePeak_ = pressure;
+    }
 
     switch (state_) {
         case AppState::CALIBRATING:
-            /* First valid reading after calibration/tare */
-            transitionTo(AppState::IDLE);
-            return;
+            break;   /* returned above; ends via processSensorEvent() */
 
         case AppState::IDLE:
-            if (aboveThreshold) {
+            if (pressed) {
+                /* Count from the first sample of the press, not from the
+                 * end of the engage dwell */
                 timerRemaining_ = timerDuration_;
-                timerStartMs_   = millis();
+                timerStartUs_   = edge ? detector_.transitionUs() : (uint32_t)micros();
+                cycleSum_       = pressure;
+                cycleSamples_   = 1;
+                cyclePeak_      = pressure;
                 transitionTo(AppState::TIMING);
             }
             break;
 
         case AppState::TIMING:
-            if (!aboveThreshold) {
+            if (!pressed) {
                 transitionTo(AppState::IDLE);
             }
             break;
 
         case AppState::ALERT:
-            if (!aboveThreshold) {
+            if (!pressed) {
                 transitionTo(AppState::IDLE);
             }
             break;
     }
+
+    /* Conversion → new state decided, across sensor and logic tasks */
+    if (state_ != before) {
+        PROF_LATENCY(SAMPLE_TO_STATE, (uint32_t)micros() - timestampUs);
+    }
+}
+
+void PressTimer::processSensorEvent(SensorEvent event)
+{
+    if (event == SensorEvent::NONE || state_ != AppState::CALIBRATING) return;
+
+    /* Done or failed, the zero in use is settled: start from released */
+    detector_.reset(false);
+    lastDisplayPressure_ = -1;
+    transitionTo(AppState::IDLE);
 }
 
 void PressTimer::processAction(const UserAction &action)
@@ -63,16 +112,14 @@ void PressTimer::processAction(const UserAction &action)
             timerDuration_ += TIMER_STEP_SECONDS;
             if (timerDuration_ > TIMER_MAX_SECONDS)
                 timerDuration_ = TIMER_MAX_SECONDS;
-            updateTimerDisplay();
-            sendTimerSettingUpdate();
+            dirty_ = true;
             break;
 
         case UserActionType::TIMER_DECREMENT:
             timerDuration_ -= TIMER_STEP_SECONDS;
             if (timerDuration_ < TIMER_MIN_SECONDS)
                 timerDuration_ = TIMER_MIN_SECONDS;
-            updateTimerDisplay();
-            sendTimerSettingUpdate();
+            dirty_ = true;
             break;
 
         case UserActionType::ACKNOWLEDGE_ALERT:
@@ -82,6 +129,7 @@ void PressTimer::processAction(const UserAction &action)
             break;
 
         case UserActionType::TARE:
+            calibStartUs_ = (uint32_t)micros();
             transitionTo(AppState::CALIBRATING);
             break;
     }
@@ -89,50 +137,96 @@ void PressTimer::processAction(const UserAction &action)
 
 void PressTimer::tick()
 {
-    if (state_ == AppState::TIMING) {
-        unsigned long elapsed = millis() - timerStartMs_;
-        int elapsedSeconds    = (int)(elapsed / 1000);
-
-        if (elapsedSeconds >= timerDuration_) {
-            timerRemaining_ = timerDuration_ - elapsedSeconds;
-            transitionTo(AppState::ALERT);
-        }
+    PROF_SCOPE(PRESS_TIMER_TICK);
+
+    uint32_t now = (uint32_t)micros();
+    uint32_t atUs;
+    if (!nextDeadline(atUs) || (int32_t)(now - atUs) < 0) return;
+
+    if (state_ == AppState::CALIBRATING) {
+        /* The sensor side always answers a tare within its own timeout;
+         * this only catches the answer being lost (sensor ring overflow) */
+        detector_.reset(false);
+        transitionTo(AppState::IDLE);
+    } else if (state_ == AppState::TIMING) {
+        alertLatenessUs_ = now - atUs;
+        PROF_LATENCY(ALERT_LATENESS, alertLatenessUs_);
+        alertStartUs_    = now;
+        timerRemaining_  = timerDuration_ - (int)((now - timerStartUs_) / 1000000UL);
+        transitionTo(AppState::ALERT);
+    }
+}
+
+bool PressTimer::nextDeadline(uint32_t &atUs) const
+{
+    switch (state_) {
+        case AppState::TIMING:
+            /* Exactly onset + duration; re-read so +/- while timing applies */
+            atUs = timerStartUs_ + (uint32_t)timerDuration_ * 1000000UL;
+            return true;
+
+        case AppState::CALIBRATING:
+            atUs = calibStartUs_ + (LOADCELL_TARE_TIMEOUT_MS + PRESS_TARE_GRACE_MS) * 1000UL;
+            return true;
+
+        default:
+            return false;
     }
 }
 
 void PressTimer::transitionTo(AppState newState)
 {
+    if ((state_ == AppState::TIMING || state_ == AppState::ALERT) &&
+        (newState == AppState::IDLE || newState == AppState::CALIBRATING)) {
+        finishCycle(newState);
+    }
+
     state_ = newState;
 
-    UICommand cmd;
-    cmd.type  = UICommandType::UPDATE_STATE;
-    cmd.state = newState;
-    sendUICommand(cmd);
+    stateSeq_++;
+    dirty_ = true;
 
     if (newState == AppState::IDLE) {
         timerRemaining_ = timerDuration_;
-        updateTimerDisplay();
     }
 }
 
-void PressTimer::sendUICommand(const UICommand &cmd)
+void PressTimer::finishCycle(AppState next)
 {
-    /* Non-blocking: if queue is full, drop the message */
-    xQueueSend(uiQueue_, &cmd, 0);
-}
+    if (!cycleSink_) return;
+
+    uint32_t now = (uint32_t)micros();
+    uint32_t durationMs = (now - timerStartUs_) / 1000UL;
+    PressCycle cycle;
+    cycle.startMs      = (uint32_t)millis() - durationMs;
+    cycle.durationMs   = durationMs;
+    cycle.overtimeMs   = state_ == AppState::ALERT ? (now - alertStartUs_) / 1000UL : 0;
+    cycle.peak         = cyclePeak_;
+    cycle.mean         = cycleSamples_ ? (pressure_cg_t)(cycleSum_ / (int64_t)cycleSamples_) : 0;
+    cycle.timerSeconds = (uint16_t)timerDuration_;
+    cycle.flags        = 0;
+    if (state_ == AppState::ALERT) cycle.flags |= CYCLE_ALERTED;
+    if (next == AppState::CALIBRATING) {
+        cycle.flags |= CYCLE_ABORTED;
+    } else if (detector_.isPressed()) {
+        cycle.flags |= CYCLE_ACKNOWLEDGED;   /* still closed: ended by the button */
+    }
 
-void PressTimer::updateTimerDisplay()
-{
-    UICommand cmd;
-    cmd.type         = UICommandType::UPDATE_TIMER;
-    cmd.timerSeconds = timerDuration_;
-    sendUICommand(cmd);
+    cycleSink_(cycle, cycleCtx_);
 }
 
-void PressTimer::sendTimerSettingUpdate()
+bool PressTimer::publish()
 {
-    UICommand cmd;
-    cmd.type         = UICommandType::UPDATE_TIMER_SETTING;
-    cmd.timerSeconds = timerDuration_;
-    sendUICommand(cmd);
+    if (!dirty_) return false;
+
+    AppSnapshot snap = {};
+    snap.stateSeq     = stateSeq_;
+    snap.pressure     = displayPressure_;
+    snap.timerSeconds = timerDuration_;
+    snap.timerStartUs = timerStartUs_;
+    snap.state        = state_;
+
+    snapshot_.write(snap);
+    dirty_ = false;
+    return true;
 }
@@ -1,7 +1,9 @@
 #ifndef PRESS_TIMER_H
 #define PRESS_TIMER_H
 
+#include "app_snapshot.h"
 #include "app_state.h"
+#include "press_detector.h"
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
 
@@ -11,13 +13,31 @@
  */
 class PressTimer {
 public:
-    PressTimer(QueueHandle_t uiQueue, QueueHandle_t actionQueue);
+    /** Receives each finished press cycle (logic task context) */
+    typedef void (*CycleSink)(const PressCycle &cycle, void *ctx);
+
+    PressTimer(AppSnapshotChannel &snapshot, QueueHandle_t actionQueue);
+
+    void setCycleSink(CycleSink fn, void *ctx);
+
+    /**
+     * Set the countdown duration (e.g. restored from settings), clamped to
+     * TIMER_MIN/MAX_SECONDS.
+     */
+    void setTimerDuration(int seconds);
 
     /**
      * Process a new pressure reading.
-     * Evaluates state transitions and sends UI commands.
+     * Evaluates state transitions.
+     * @param timestampUs  Conversion time of the reading (SensorData)
      */
-    void processPressure(float pressure);
+    void processPressure(pressure_cg_t pressure, uint32_t timestampUs);
+
+    /**
+     * Process a sensor event. TARE_DONE / TARE_FAILED end CALIBRATING;
+     * on failure the previous zero stays in use.
+     */
+    void processSensorEvent(SensorEvent event);
 
     /**
      * Process a user action (button press).
@@ -25,30 +45,69 @@ public:
     void processAction(const UserAction &action);
 
     /**
-     * Called periodically (~100ms) to update countdown.
+     * Run time-driven transitions (alert on expiry, tare overdue).
+     * Cheap; call after every wakeup and at nextDeadline().
      */
     void tick();
 
+    /**
+     * When tick() next has work to do. The alert deadline is the press
+     * onset plus the timer setting, to the microsecond; the caller arms a
+     * one-shot for it rather than polling.
+     * @param[out] atUs  micros() value of the deadline (wraps; compare
+     *                   with a signed difference)
+     * @return false if no deadline is pending (nothing to wake up for)
+     */
+    bool nextDeadline(uint32_t &atUs) const;
+
+    /** How late tick() ran the last alert, past its deadline (µs) */
+    uint32_t alertLatenessUs() const { return alertLatenessUs_; }
+
+    /**
+     * Publish the UI snapshot if anything shown on screen changed since
+     * the last call. Call once per wakeup, after processing everything.
+     * @return true if a new snapshot was written (wake the UI)
+     */
+    bool publish();
+
     AppState getState() const { return state_; }
     int getTimerDuration() const { return timerDuration_; }
     int getTimerRemaining() const { return timerRemaining_; }
+    const PressDetector &getDetector() const { return detector_; }
 
 private:
     void transitionTo(AppState newState);
-    void sendUICommand(const UICommand &cmd);
-    void updateTimerDisplay();
-    void sendTimerSettingUpdate();
+    void finishCycle(AppState next);
 
-    QueueHandle_t uiQueue_;
+    AppSnapshotChannel &snapshot_;
     QueueHandle_t actionQueue_;
 
+    PressDetector detector_;
+
     AppState state_           = AppState::IDLE;
     int      timerDuration_   = 0;   /* Set from config on construction */
     int      timerRemaining_  = 0;
-    float    currentPressure_ = 0.0f;
-    int      lastDisplayPressure_ = -1; /* tracks displayed value to avoid redundant updates */
+    pressure_cg_t currentPressure_ = 0;
+    int32_t  lastDisplayPressure_ = -1; /* tracks displayed value to avoid redundant updates */
+    pressure_cg_t displayPressure_ = 0;
+
+    /* Snapshot bookkeeping */
+    uint32_t stateSeq_ = 0;
+    bool     dirty_    = true;
+
+    /* micros() timestamps; 32-bit, compared by difference */
+    uint32_t timerStartUs_    = 0;
+    uint32_t calibStartUs_    = 0;
+    uint32_t alertLatenessUs_ = 0;
+
+    /* Statistics of the cycle in progress */
+    uint32_t      alertStartUs_  = 0;
+    int64_t       cycleSum_      = 0;
+    uint32_t      cycleSamples_  = 0;
+    pressure_cg_t cyclePeak_     = 0;
 
-    unsigned long timerStartMs_  = 0;
+    CycleSink cycleSink_ = nullptr;
+    void     *cycleCtx_  = nullptr;
 };
 
 #endif /* PRESS_TIMER_H */
@@ -0,0 +1,57 @@
+#ifndef PRESSURE_H
+#define PRESSURE_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * Fixed-point pressure representation.
+ *
+ * Readings are converted from the HX711 float once, in loadcell_read(),
+ * and carried as integer centigrams (0.01 g, ±21 t range) through
+ * SensorData, PressTimer and UICommand. Display conversions use
+ * precomputed constants, so the per-sample path has no float math.
+ */
+typedef int32_t pressure_cg_t;
+
+static constexpr pressure_cg_t PRESSURE_CG_PER_GRAM = 100;
+
+/** PRESSURE_THRESHOLD / PRESSURE_RELEASE_THRESHOLD (grams) in centigrams */
+static constexpr pressure_cg_t PRESSURE_THRESHOLD_CG =
+    (pressure_cg_t)(PRESSURE_THRESHOLD * PRESSURE_CG_PER_GRAM);
+static constexpr pressure_cg_t PRESSURE_RELEASE_THRESHOLD_CG =
+    (pressure_cg_t)(PRESSURE_RELEASE_THRESHOLD * PRESSURE_CG_PER_GRAM);
+
+static_assert(PRESSURE_RELEASE_THRESHOLD_CG <= PRESSURE_THRESHOLD_CG,
+              "release threshold must not exceed the engage threshold");
+
+/* kg → N → Pa over the plate → 0.1 mbar, folded into one Q32 multiplier:
+ * dmbar = cg / 1e5 kg · g0 / area / 10 */
+static constexpr double PRESS_AREA_M2 =
+    (double)PRESS_AREA_WIDTH_MM * (double)PRESS_AREA_HEIGHT_MM * 1e-6;
+static constexpr double DMBAR_PER_CG = 9.80665 / 1e5 / PRESS_AREA_M2 / 10.0;
+static constexpr int64_t DMBAR_PER_CG_Q32 = (int64_t)(DMBAR_PER_CG * 4294967296.0 + 0.5);
+
+static_assert(DMBAR_PER_CG_Q32 > 0 && DMBAR_PER_CG_Q32 < (1LL << 31),
+              "PRESS_AREA_* out of range for the Q32 mbar factor");
+
+/** Convert an HX711 reading (grams) — the only float step, once per sample */
+inline pressure_cg_t pressure_from_grams(float grams)
+{
+    float cg = grams * (float)PRESSURE_CG_PER_GRAM;
+    return (pressure_cg_t)(cg >= 0.0f ? cg + 0.5f : cg - 0.5f);
+}
+
+/** Display value in 0.01 kg steps, rounded half away from zero like roundf() */
+inline int32_t pressure_to_centikg(pressure_cg_t cg)
+{
+    return (cg >= 0 ? cg + 500 : cg - 500) / 1000;
+}
+
+/** Display value in 0.1 mbar steps over the PRESS_AREA_* plate */
+inline int32_t pressure_to_decimbar(pressure_cg_t cg)
+{
+    return (int32_t)(((int64_t)cg * DMBAR_PER_CG_Q32 + (1LL << 31)) >> 32);
+}
+
+#endif /* PRESSURE_H */
@@ -18,7 +18,10 @@
    MEMORY SETTINGS
  *====================*/
 #define LV_MEM_CUSTOM 0
-#define LV_MEM_SIZE (48U * 1024U)  /* 48KB for LVGL */
+#ifndef LV_MEM_SIZE_KB
+#define LV_MEM_SIZE_KB 48  /* Size from the "mem" report's LVGL peak, plus headroom */
+#endif
+#define LV_MEM_SIZE (LV_MEM_SIZE_KB * 1024U)
 #define LV_MEM_ADR 0
 #define LV_MEM_BUF_MAX_NUM 16
 
@@ -33,7 +36,7 @@
    FEATURE CONFIG
  *====================*/
 #define LV_USE_PERF_MONITOR 0
-#define LV_USE_MEM_MONITOR 0
+#define LV_USE_MEM_MONITOR 0  /* On-screen overlay; the "mem" console command reports the pool instead */
 #define LV_USE_LOG 0
 
 /*====================
@@ -2,112 +2,189 @@
  * HeatPress — ESP32 Heat Press Pressure Monitor
  *
  * Architecture:
- *   - UI Task     (Core 1, high priority)  : LVGL rendering + touch
- *   - Sensor Task (Core 0, medium priority) : HX711 async reads
- *   - Logic Task  (Core 0, medium priority) : State machine + timer
+ *   - UI Task     (Core 1, high priority)  : LVGL rendering
+ *   - Touch Task  (Core 1, highest)        : XPT2046 reads, only while touched
+ *   - Sensor Task (Core 0, medium priority) : HX711 reads (DRDY IRQ or polled)
+ *   - Logic Task  (Core 0, medium priority) : State machine + timer, woken
+ *                                            only by samples, button presses
+ *                                            and its countdown deadline
  *
  * Communication:
- *   sensorQueue : SensorData   (sensor → logic)
- *   uiQueue     : UICommand    (logic  → UI)
+ *   sensorRing  : SensorData   (sensor → logic, lock-free SPSC)
+ *   appSnapshot : AppSnapshot  (logic  → UI, seqlock; read once per frame)
  *   actionQueue : UserAction   (UI     → logic)
  */
 
 #include <Arduino.h>
+#include <esp_timer.h>
 #include <lvgl.h>
 
 #include "config.h"
+#include "app/task_steps.h"
 #include "display/lv_setup.h"
+#include "display/touch.h"
 #include "sensors/loadcell.h"
 #include "logic/app_state.h"
 #include "logic/press_timer.h"
+#include "logic/app_snapshot.h"
 #include "ui/ui_theme.h"
 #include "ui/ui_screen.h"
 #include "ui/ui_update.h"
+#include "ui/ui_retained.h"
+#include "ui/ui_touch_cal.h"
 #include "audio/buzzer.h"
-
-/* ── FreeRTOS Queues ─────────────────────────────────────── */
-static QueueHandle_t sensorQueue = nullptr;   // SensorData
-static QueueHandle_t uiQueue     = nullptr;   // UICommand
+#include "util/spsc_ring.h"
+#include "util/rtos_storage.h"
+#include "diag/console.h"
+#include "diag/profiler.h"
+#include "diag/telemetry.h"
+#include "diag/mem_report.h"
+#include "diag/boot_timeline.h"
+#include "storage/cycle_log.h"
+#include "storage/settings.h"
+
+/* ── Inter-task channels ─────────────────────────────────── */
+static SensorRing sensorRing;                 // every sample, in order
+static AppSnapshotChannel appSnapshot;        // what the UI shows, published by PressTimer
 static QueueHandle_t actionQueue = nullptr;   // UserAction
 
+/* Task stacks/TCBs and the action queue (in .bss with RTOS_STATIC_ALLOC) */
+static TaskStorage<UI_TASK_STACK_SIZE>     uiTaskStorage;
+static TaskStorage<SENSOR_TASK_STACK_SIZE> sensorTaskStorage;
+static TaskStorage<LOGIC_TASK_STACK_SIZE>  logicTaskStorage;
+static QueueStorage<UserAction, QUEUE_SIZE> actionQueueStorage;
+
+/* Notified after the logic task publishes a snapshot (wakes an idle UI) */
+static TaskHandle_t uiTaskHandle     = nullptr;
+static TaskHandle_t sensorTaskHandle = nullptr;
+static TaskHandle_t logicTaskHandle  = nullptr;
+
+/* Logic task wake reasons (direct-to-task notification bits) */
+static constexpr uint32_t LOGIC_WAKE_SAMPLE   = 1u << 0;   /* sensorRing has data */
+static constexpr uint32_t LOGIC_WAKE_ACTION   = 1u << 1;   /* actionQueue has data */
+static constexpr uint32_t LOGIC_WAKE_DEADLINE = 1u << 2;   /* deadlineTimer expired */
+
+/* One-shot for PressTimer::nextDeadline() (alert due, tare overdue).
+ * esp_timer rather than a FreeRTOS timer: µs resolution, not 1 ms ticks */
+static esp_timer_handle_t deadlineTimer = nullptr;
+
+static void notify_logic(uint32_t reason)
+{
+    if (logicTaskHandle) xTaskNotify(logicTaskHandle, reason, eSetBits);
+}
+
 /* ── Sensor init complete flag ────────────────────────────── */
 static volatile bool sensorInitDone  = false;
 static volatile bool sensorInitOk    = false;
 
-/* ── Spinner overlay helper ───────────────────────────────── */
+/* ── Touch calibration ───────────────────────────────────── */
+
+static void touch_cal_done(const TouchCal &cal, void *ctx)
+{
+    lv_setup_set_touch_cal(cal);
+    settings_set_touch_cal(cal);
+}
 
-static lv_obj_t* create_spinner_overlay(lv_obj_t *parent, const char *text)
+static void cmd_touchcal(const char *args)
 {
-    lv_obj_t *overlay = lv_obj_create(parent);
-    lv_obj_set_size(overlay, SCREEN_WIDTH, SCREEN_HEIGHT);
-    lv_obj_align(overlay, LV_ALIGN_CENTER, 0, 0);
-    lv_obj_set_style_bg_color(overlay, COLOR_BG, 0);
-    lv_obj_set_style_bg_opa(overlay, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_width(overlay, 0, 0);
-    lv_obj_clear_flag(overlay, LV_OBJ_FLAG_SCROLLABLE);
-
-    lv_obj_t *spinner = lv_spinner_create(overlay, 1000, 60);
-    lv_obj_set_size(spinner, 60, 60);
-    lv_obj_align(spinner, LV_ALIGN_CENTER, 0, -20);
-    lv_obj_set_style_arc_color(spinner, COLOR_SURFACE, LV_PART_MAIN);
-    lv_obj_set_style_arc_color(spinner, COLOR_PRIMARY, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_width(spinner, 6, LV_PART_MAIN);
-    lv_obj_set_style_arc_width(spinner, 6, LV_PART_INDICATOR);
-
-    lv_obj_t *label = lv_label_create(overlay);
-    lv_obj_add_style(label, &style_label_small, 0);
-    lv_label_set_text(label, text);
-    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_align(label, LV_ALIGN_CENTER, 0, 30);
-
-    return overlay;
+    if (strcmp(args, "start") == 0) {
+        ui_touch_cal_request();
+        return;
+    }
+    if (strcmp(args, "reset") == 0) {
+        settings_clear_touch_cal();
+        Serial.println("default touch mapping applies after reboot");
+    } else if (*args != '\0') {
+        Serial.println("usage: touchcal [start | reset]");
+        return;
+    }
+
+    Settings s;
+    settings_get(s);
+    TouchCal c;
+    lv_setup_get_touch_cal(c);
+    Serial.printf("x = (%ld*rx + %ld*ry + %ld) >> 16\n", (long)c.a, (long)c.b, (long)c.c);
+    Serial.printf("y = (%ld*rx + %ld*ry + %ld) >> 16\n", (long)c.d, (long)c.e, (long)c.f);
+    Serial.printf("saved=%s\n", s.touchCalValid ? "yes" : "no (defaults)");
 }
 
 /* ── UI Task ─────────────────────────────────────────────── */
 
+static void apply_ui_command(const UICommand &cmd, void *ctx)
+{
+    ui_handle_command(cmd);
+}
+
 static void uiTask(void *pvParam)
 {
     /* Initialize display + LVGL */
     lv_setup_init();
     ui_theme_init();
+    boot_mark(BootMark::DISPLAY_READY);
 
-    /* ── Init / splash screen ───────────────────────── */
-    lv_obj_t *initScr = create_spinner_overlay(
-        lv_scr_act(), "Calibrating...\nDo not apply pressure");
-
-    /* Drive LVGL while waiting for sensor init */
-    TickType_t xLastWake = xTaskGetTickCount();
-    while (!sensorInitDone) {
-        lv_setup_update();
-        vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(UI_REFRESH_PERIOD_MS));
-    }
-
-    /* Remove init screen */
-    lv_obj_del(initScr);
+    /* Saved touch mapping, if the calibration screen has been run */
+    Settings cfg;
+    settings_get(cfg);
+    if (cfg.touchCalValid) lv_setup_set_touch_cal(cfg.touchCal);
 
     /* ── Build main screen ──────────────────────────── */
+    /* Right away, while the load cell settles on the other core; the
+     * calibrating overlay covers it until sensor init is done */
     ui_screen_create(actionQueue);
+    ui_set_booting(true);
+    lv_obj_update_layout(ui_get_screen());
+    lv_refr_now(nullptr);
+    boot_mark(BootMark::MAIN_SCREEN);
+
+    ui_touch_cal_init(touch_cal_done, nullptr);
 
     /* ── Initialize buzzer for alert beeps ───────────── */
     buzzer_init();
 
-    xLastWake = xTaskGetTickCount();
+    /* Last snapshot applied to the widgets */
+    UiShownState shown;
+
+    bool booting       = true;
+    bool pressureShown = false;
+
+    TickType_t xLastWake = xTaskGetTickCount();
 
     for (;;) {
-        /* Process all pending UI commands from the logic task */
-        UICommand cmd;
-        while (xQueueReceive(uiQueue, &cmd, 0) == pdTRUE) {
-            ui_handle_command(cmd);
+        if (booting && sensorInitDone) {
+            booting = false;
+            ui_set_booting(false);
         }
 
-        /* Smooth arc animation (local timing, every frame) */
-        ui_arc_tick();
+        /* Checked before reading the snapshot, so the one read below
+         * already carries the first measured pressure */
+        bool pressureReady = !pressureShown && boot_reached(BootMark::PRESSURE_PUBLISHED);
 
-        /* Drive LVGL (rendering, animations, input) */
-        lv_setup_update();
+        /* Apply whatever changed in the logic task's snapshot */
+        ui_task_apply_snapshot(appSnapshot, shown, apply_ui_command, nullptr);
+
+        uint32_t nextTimerMs;
+        bool     fullRate = ui_task_frame(nextTimerMs);
+
+        if (pressureReady && !booting) {
+            lv_refr_now(nullptr);   /* on the panel now, not at the next refresh period */
+            boot_mark(BootMark::PRESSURE_SHOWN);
+            pressureShown = true;
+        }
 
-        /* Maintain steady frame rate */
-        vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(UI_REFRESH_PERIOD_MS));
+        /* Button callbacks ran inside LVGL; hand their actions over now */
+        if (uxQueueMessagesWaiting(actionQueue) > 0) {
+            notify_logic(LOGIC_WAKE_ACTION);
+        }
+
+        if (fullRate) {
+            /* Maintain steady frame rate */
+            vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(UI_REFRESH_PERIOD_MS));
+        } else {
+            /* Nothing animating: sleep until LVGL's next timer, a snapshot
+             * (the logic task notifies us) or a touch (T_IRQ notifies us) */
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ui_task_idle_sleep_ms(nextTimerMs)));
+            xLastWake = xTaskGetTickCount();
+        }
     }
 }
 
@@ -115,69 +192,111 @@ static void uiTask(void *pvParam)
 
 static void sensorTask(void *pvParam)
 {
-    /* Initialize load cell (blocking ~2s tare) */
+    /* Initialize load cell (blocking settle + tare; the UI is built meanwhile) */
     bool ok = loadcell_init();
+    if (ok) boot_mark(BootMark::LOADCELL_READY);
     sensorInitOk   = ok;
     sensorInitDone = true;
 
     if (!ok) {
         /* Send error pressure forever so UI shows something */
-        SensorData errData = { 0.0f, false };
+        SensorData errData = { 0, 0, false, 0, 0, SensorEvent::NONE };
         for (;;) {
-            xQueueOverwrite(sensorQueue, &errData);
+            sensorRing.push(errData);
+            notify_logic(LOGIC_WAKE_SAMPLE);
             vTaskDelay(pdMS_TO_TICKS(1000));
         }
     }
 
-    TickType_t xLastWake = xTaskGetTickCount();
-
     for (;;) {
-        float pressure = 0.0f;
-        bool isNew = loadcell_read(pressure);
+        /* DRDY interrupt or poll slot, depending on LOADCELL_ACQ_MODE */
+        loadcell_wait();
 
-        if (isNew) {
-            SensorData data = { pressure, true };
-            xQueueOverwrite(sensorQueue, &data);
+        SensorData data;
+        if (sensor_task_step(sensorRing, data)) {
+            if (data.isValid) boot_mark(BootMark::FIRST_SAMPLE);
+            notify_logic(LOGIC_WAKE_SAMPLE);
         }
-
-        vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(SENSOR_READ_INTERVAL_MS));
     }
 }
 
 /* ── Logic Task ──────────────────────────────────────────── */
 
+static void deadline_cb(void *arg)
+{
+    notify_logic(LOGIC_WAKE_DEADLINE);
+}
+
+/* Point deadlineTimer at the state machine's next deadline, if it moved */
+static void arm_deadline(const PressTimer &timer, bool &armed, uint32_t &armedAtUs)
+{
+    uint32_t atUs;
+    if (!timer.nextDeadline(atUs)) {
+        if (armed) esp_timer_stop(deadlineTimer);
+        armed = false;
+        return;
+    }
+    if (armed && atUs == armedAtUs) return;
+
+    int32_t waitUs = (int32_t)(atUs - (uint32_t)esp_timer_get_time());
+    if (waitUs < 1) waitUs = 1;
+
+    if (armed) esp_timer_stop(deadlineTimer);
+    esp_timer_start_once(deadlineTimer, (uint64_t)waitUs);
+    armed     = true;
+    armedAtUs = atUs;
+}
+
+static void telemetry_sample(const TelemetrySample &sample, void *ctx)
+{
+    telemetry_push(sample);
+}
+
+static void persist_timer(const UserAction &action, const PressTimer &timer, void *ctx)
+{
+    /* Lazily persisted: a burst of +/- presses is one NVS write */
+    settings_set_timer(timer.getTimerDuration());
+}
+
 static void logicTask(void *pvParam)
 {
-    PressTimer timer(uiQueue, actionQueue);
+    PressTimer timer(appSnapshot, actionQueue);
+    timer.setCycleSink(cyclelog_append, nullptr);
 
-    /* Send initial timer display */
-    UICommand initCmd;
-    initCmd.type         = UICommandType::UPDATE_TIMER;
-    initCmd.timerSeconds = TIMER_DEFAULT_SECONDS;
-    xQueueSend(uiQueue, &initCmd, portMAX_DELAY);
+    /* Restore the saved timer setting (also sends the initial timer display) */
+    Settings cfg;
+    settings_get(cfg);
+    timer.setTimerDuration(cfg.timerSeconds);
+    timer.publish();
+
+    const LogicTaskHooks hooks = { telemetry_sample, persist_timer, nullptr };
+
+    bool     deadlineArmed = false;
+    uint32_t deadlineAtUs  = 0;
+    bool     gotPressure   = false;   /* boot timeline */
 
     for (;;) {
-        /* Check for new sensor data */
-        SensorData sensorData;
-        if (xQueueReceive(sensorQueue, &sensorData, 0) == pdTRUE) {
-            if (sensorData.isValid) {
-                timer.processPressure(sensorData.pressure);
-            }
+        /* Sleep until a sample, a button press or the deadline; with the
+         * press idle that is the next conversion, not a polling period */
+        uint32_t wake = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &wake, portMAX_DELAY);
+        if (wake & LOGIC_WAKE_DEADLINE) deadlineArmed = false;
+
+        LogicStepResult step = logic_task_step(timer, sensorRing, actionQueue, hooks);
+        gotPressure = gotPressure || step.gotPressure;
+
+        /* Re-arm for the next time-driven transition */
+        arm_deadline(timer, deadlineArmed, deadlineAtUs);
+
+        /* Wake the UI task if it is idle */
+        bool published = step.published;
+        if (gotPressure && !boot_reached(BootMark::PRESSURE_PUBLISHED)) {
+            boot_mark(BootMark::PRESSURE_PUBLISHED);
+            published = true;   /* unchanged "0.00" still needs its frame */
         }
-
-        /* Check for user actions */
-        UserAction action;
-        while (xQueueReceive(actionQueue, &action, 0) == pdTRUE) {
-            if (action.type == UserActionType::TARE) {
-                loadcell_request_tare();
-            }
-            timer.processAction(action);
+        if (published && uiTaskHandle) {
+            xTaskNotifyGive(uiTaskHandle);
         }
-
-        /* Tick the state machine (countdown updates) */
-        timer.tick();
-
-        vTaskDelay(pdMS_TO_TICKS(LOGIC_TICK_INTERVAL_MS));
     }
 }
 
@@ -185,31 +304,105 @@ static void logicTask(void *pvParam)
 
 void setup()
 {
+    boot_mark(BootMark::SETUP);
     Serial.begin(115200);
     Serial.println("HeatPress starting...");
 
+    /* Settings first: the sensor and logic tasks read them at startup */
+    settings_init();
+
     /* Create queues */
-    sensorQueue = xQueueCreate(1, sizeof(SensorData));     // Overwrite-style
-    uiQueue     = xQueueCreate(QUEUE_SIZE, sizeof(UICommand));
-    actionQueue = xQueueCreate(QUEUE_SIZE, sizeof(UserAction));
-
-    /* Create tasks pinned to specific cores */
-    xTaskCreatePinnedToCore(
-        uiTask, "UI", UI_TASK_STACK_SIZE, nullptr,
-        UI_TASK_PRIORITY, nullptr, UI_TASK_CORE);
-
-    xTaskCreatePinnedToCore(
-        sensorTask, "Sensor", SENSOR_TASK_STACK_SIZE, nullptr,
-        SENSOR_TASK_PRIORITY, nullptr, SENSOR_TASK_CORE);
-
-    xTaskCreatePinnedToCore(
-        logicTask, "Logic", LOGIC_TASK_STACK_SIZE, nullptr,
-        LOGIC_TASK_PRIORITY, nullptr, LOGIC_TASK_CORE);
+    actionQueue = actionQueueStorage.create();
+
+    /* Dispatched from the esp_timer task, which only notifies logicTask */
+    esp_timer_create_args_t deadlineArgs = {};
+    deadlineArgs.callback = deadline_cb;
+    deadlineArgs.name     = "deadline";
+    esp_timer_create(&deadlineArgs, &deadlineTimer);
+
+    /* Create tasks pinned to specific cores. Sensor first: the HX711
+     * settles on core 0 while the UI task (which preempts setup() on
+     * core 1) brings up the display */
+    sensorTaskStorage.create(
+        sensorTask, "Sensor", nullptr,
+        SENSOR_TASK_PRIORITY, &sensorTaskHandle, SENSOR_TASK_CORE);
+
+    logicTaskStorage.create(
+        logicTask, "Logic", nullptr,
+        LOGIC_TASK_PRIORITY, &logicTaskHandle, LOGIC_TASK_CORE);
+
+    uiTaskStorage.create(
+        uiTask, "UI", nullptr,
+        UI_TASK_PRIORITY, &uiTaskHandle, UI_TASK_CORE);
+
+    telemetry_init();
+    cyclelog_init();
+    console_register("touchcal", "Touch mapping [start | reset]", cmd_touchcal);
+
+    /* Touch and Telemetry register themselves */
+    mem_report_register_task("UI", uiTaskHandle, UI_TASK_STACK_SIZE);
+    mem_report_register_task("Sensor", sensorTaskHandle, SENSOR_TASK_STACK_SIZE);
+    mem_report_register_task("Logic", logicTaskHandle, LOGIC_TASK_STACK_SIZE);
+    mem_report_register_task("loop", xTaskGetCurrentTaskHandle(), CONFIG_ARDUINO_LOOP_STACK_SIZE);
+    mem_report_init();
+    boot_timeline_init();
+
+#if PROFILER_ENABLED
+    profiler_init();
+#endif
+    boot_mark(BootMark::TASKS_STARTED);
 }
 
 void loop()
 {
-    /* All work is done in FreeRTOS tasks; nothing needed here.
-     * Yield to avoid watchdog issues. */
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    /* All real work is done in FreeRTOS tasks; this one only serves the
+     * diagnostics console. Yield to avoid watchdog issues. */
+    vTaskDelay(pdMS_TO_TICKS(CONSOLE_POLL_MS));
+    console_poll();
+
+#if PROFILER_ENABLED
+    profiler_poll();
+#endif
+    cyclelog_poll();
+    settings_poll();
+    mem_report_poll();
+    boot_timeline_poll();
+
+    static uint32_t lastReportMs = 0;
+    if (millis() - lastReportMs < 1000) return;
+    lastReportMs = millis();
+
+#if FRAME_STATS_REPORT
+    FrameStats fs;
+    lv_setup_get_frame_stats(fs);
+    static const char *const RENDER_MODE[] = { "partial", "direct", "full" };
+    Serial.printf("frames[%s %s %ux%u]: frames=%u flushes=%u px=%u last=%ums max=%ums "
+                  "avg=%ums blocked=%uus\n",
+                  DISPLAY_USE_DMA && !DISPLAY_BUF_PSRAM ? "dma" : "blocking",
+                  RENDER_MODE[DISPLAY_RENDER_MODE], (unsigned)fs.bufCount,
+                  (unsigned)fs.bufLines,
+                  (unsigned)fs.frames, (unsigned)fs.flushes, (unsigned)fs.flushedPx,
+                  (unsigned)fs.lastFrameMs, (unsigned)fs.maxFrameMs,
+                  (unsigned)(fs.frames ? fs.totalFrameMs / fs.frames : 0),
+                  (unsigned)fs.flushBlockedUs);
+    UiRetainedStats rs;
+    ui_retained_get_stats(rs);
+    Serial.printf("ui: applied=%u skipped=%u\n", (unsigned)rs.applied, (unsigned)rs.skipped);
+    TouchStats ts;
+    touch_get_stats(ts);
+    Serial.printf("touch: wakeups=%u reads=%u touches=%u\n",
+                  (unsigned)ts.wakeups, (unsigned)ts.reads, (unsigned)ts.touches);
+#endif
+
+#if LOADCELL_STATS_REPORT
+    LoadcellStats st;
+    loadcell_get_stats(st);
+    Serial.printf("loadcell[%s]: samples=%u wakeups=%u empty=%u "
+                  "latency=%uus max=%uus busy=%uus tares=%u failed=%u\n",
+                  LOADCELL_ACQ_MODE == LOADCELL_ACQ_IRQ ? "irq" : "poll",
+                  (unsigned)st.samples, (unsigned)st.wakeups,
+                  (unsigned)st.emptyWakeups, (unsigned)st.lastLatencyUs,
+                  (unsigned)st.maxLatencyUs, (unsigned)st.busyUs,
+                  (unsigned)st.tares, (unsigned)st.tareFailures);
+#endif
 }
\ No newline at end of file
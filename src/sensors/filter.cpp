@@ -0,0 +1,97 @@
+#include "filter.h"
+#include "../config.h"
+
+FilterConfig filter_default_config()
+{
+    FilterConfig cfg;
+    cfg.medianWindow  = FILTER_MEDIAN_WINDOW;
+    cfg.iirAlphaQ15   = (uint16_t)(FILTER_IIR_ALPHA * 32768.0f + 0.5f);
+    cfg.iirBypassCg   = (pressure_cg_t)(FILTER_IIR_BYPASS_G * PRESSURE_CG_PER_GRAM);
+    cfg.kalmanEnabled = FILTER_KALMAN_ENABLED;
+    cfg.kalmanQ       = FILTER_KALMAN_Q;
+    cfg.kalmanR       = FILTER_KALMAN_R;
+    return cfg;
+}
+
+FilterChain::FilterChain()
+{
+    configure(filter_default_config());
+}
+
+void FilterChain::configure(const FilterConfig &cfg)
+{
+    cfg_ = cfg;
+    if (cfg_.medianWindow > FILTER_MEDIAN_MAX) cfg_.medianWindow = FILTER_MEDIAN_MAX;
+    if (cfg_.medianWindow > 1 && (cfg_.medianWindow & 1) == 0) cfg_.medianWindow--;
+    if (cfg_.iirAlphaQ15 > 32768) cfg_.iirAlphaQ15 = 32768;
+    if (cfg_.iirBypassCg < 0) cfg_.iirBypassCg = 0;
+    reset();
+}
+
+void FilterChain::reset()
+{
+    windowPos_   = 0;
+    windowCount_ = 0;
+    iirPrimed_   = false;
+    kPrimed_     = false;
+}
+
+pressure_cg_t FilterChain::apply(pressure_cg_t x)
+{
+    if (cfg_.medianWindow > 1) x = median(x);
+    if (cfg_.iirAlphaQ15 > 0)  x = iir(x);
+    if (cfg_.kalmanEnabled)    x = kalman(x);
+    return x;
+}
+
+/* ── Stages ──────────────────────────────────────────────── */
+
+pressure_cg_t FilterChain::median(pressure_cg_t x)
+{
+    window_[windowPos_] = x;
+    windowPos_ = (uint8_t)((windowPos_ + 1) % cfg_.medianWindow);
+    if (windowCount_ < cfg_.medianWindow) windowCount_++;
+
+    /* Insertion sort of ≤ 7 values beats any cleverer structure here */
+    pressure_cg_t sorted[FILTER_MEDIAN_MAX];
+    for (uint8_t i = 0; i < windowCount_; i++) {
+        pressure_cg_t v = window_[i];
+        int8_t j = (int8_t)i - 1;
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+    return sorted[windowCount_ / 2];
+}
+
+pressure_cg_t FilterChain::iir(pressure_cg_t x)
+{
+    int64_t xs = (int64_t)x << 8;
+    if (!iirPrimed_) {
+        iirState_  = xs;
+        iirPrimed_ = true;
+    } else if (cfg_.iirBypassCg > 0 && xs < iirState_ - ((int64_t)cfg_.iirBypassCg << 8)) {
+        iirState_ = xs;   /* load removed: don't lag the release */
+    } else {
+        iirState_ += ((xs - iirState_) * cfg_.iirAlphaQ15) >> 15;
+    }
+    return (pressure_cg_t)((iirState_ + 128) >> 8);
+}
+
+pressure_cg_t FilterChain::kalman(pressure_cg_t x)
+{
+    float z = (float)x;
+    if (!kPrimed_) {
+        kx_      = z;
+        kp_      = cfg_.kalmanR;
+        kPrimed_ = true;
+    } else {
+        kp_ += cfg_.kalmanQ;
+        float k = kp_ / (kp_ + cfg_.kalmanR);
+        kx_ += k * (z - kx_);
+        kp_ *= (1.0f - k);
+    }
+    return (pressure_cg_t)(kx_ >= 0.0f ? kx_ + 0.5f : kx_ - 0.5f);
+}
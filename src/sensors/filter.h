@@ -0,0 +1,72 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdint.h>
+#include "../logic/pressure.h"
+
+/**
+ * Per-sample digital filter chain for load-cell readings.
+ *
+ * Stages run in order, each optional:
+ *   1. Median over the last N samples (spike rejection, N ≤ FILTER_MEDIAN_MAX)
+ *   2. One-pole IIR low-pass, y += α·(x − y), α in Q15. A drop of more
+ *      than iirBypassCg below y jumps straight to x, so opening the press
+ *      is not smeared over several samples
+ *   3. 1-D Kalman filter (random-walk model)
+ *
+ * Cost per sample is bounded: O(N) for the median, constant otherwise.
+ * Pure integer except the Kalman stage, and free of hardware
+ * dependencies so it runs (and benchmarks) on the host.
+ */
+
+static constexpr uint8_t FILTER_MEDIAN_MAX = 7;
+
+struct FilterConfig {
+    uint8_t       medianWindow;    // 0 or 1 = off, otherwise odd, ≤ FILTER_MEDIAN_MAX
+    uint16_t      iirAlphaQ15;     // 0 = off; 32768 = passthrough
+    pressure_cg_t iirBypassCg;     // drop below the IIR output that resets it, 0 = never
+    bool          kalmanEnabled;
+    float         kalmanQ;         // process noise variance (cg² per sample)
+    float         kalmanR;         // measurement noise variance (cg²)
+};
+
+/** Defaults from config.h (FILTER_*) */
+FilterConfig filter_default_config();
+
+class FilterChain {
+public:
+    FilterChain();
+
+    /** Replace the configuration; clears filter state */
+    void configure(const FilterConfig &cfg);
+    const FilterConfig &config() const { return cfg_; }
+
+    /** Forget history (e.g. after a tare); next sample passes through */
+    void reset();
+
+    /** Filter one sample */
+    pressure_cg_t apply(pressure_cg_t x);
+
+private:
+    pressure_cg_t median(pressure_cg_t x);
+    pressure_cg_t iir(pressure_cg_t x);
+    pressure_cg_t kalman(pressure_cg_t x);
+
+    FilterConfig cfg_;
+
+    /* Median: ring of recent samples + count */
+    pressure_cg_t window_[FILTER_MEDIAN_MAX];
+    uint8_t       windowPos_   = 0;
+    uint8_t       windowCount_ = 0;
+
+    /* IIR state with 8 extra fractional bits to avoid truncation bias */
+    int64_t iirState_  = 0;
+    bool    iirPrimed_ = false;
+
+    /* Kalman state */
+    float kx_      = 0.0f;
+    float kp_      = 0.0f;
+    bool  kPrimed_ = false;
+};
+
+#endif /* FILTER_H */
@@ -1,48 +1,262 @@
 #include "loadcell.h"
 #include "../config.h"
+#include "../diag/profiler.h"
+#include "../storage/settings.h"
+#include "tare.h"
+#include "../util/seqlock.h"
 
 #include <HX711_ADC.h>
 #include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 static HX711_ADC LoadCell(PIN_HX711_DT, PIN_HX711_CLK);
 
 /* Atomic tare request flag (safe across tasks) */
 static volatile bool tareRequested = false;
 
+/* Tare in progress (sensor task only) */
+static TareEstimator tare;
+static uint32_t      tareStartUs  = 0;
+static SensorEvent   pendingEvent = SensorEvent::NONE;
+
+/* Filter chain (sensor task only) + pending config handed over from other tasks */
+static FilterChain  filterChain;
+static FilterConfig pendingFilter;
+static FilterConfig activeFilter = filter_default_config();   /* filterChain.config(), readable under filterMux */
+static volatile bool filterPending = false;
+static portMUX_TYPE filterMux = portMUX_INITIALIZER_UNLOCKED;
+
+/* ── DRDY interrupt ──────────────────────────────────────── */
+
+/* The HX711 pulls DT low when a conversion is ready. The ISR timestamps
+ * that edge in both modes; in IRQ mode it also wakes the sensor task. */
+static TaskHandle_t      sensorTask     = nullptr;
+static volatile bool     readoutActive  = false;  /* DT toggles while bits are clocked out */
+static volatile bool     drdySeen       = false;
+static volatile uint32_t drdyTimestampUs = 0;
+
+static LoadcellStats stats = {};             /* sensor task only */
+static SeqLock<LoadcellStats> statsOut;      /* copy of stats for other tasks */
+static LoadcellRaw   lastRaw = {};
+
+#if LOADCELL_ACQ_MODE == LOADCELL_ACQ_POLL
+static TickType_t lastPollWake = 0;
+#endif
+
+static void IRAM_ATTR drdy_isr()
+{
+    if (readoutActive) return;
+
+    drdyTimestampUs = (uint32_t)esp_timer_get_time();
+    drdySeen        = true;
+
+#if LOADCELL_ACQ_MODE == LOADCELL_ACQ_IRQ
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(sensorTask, &woken);
+    if (woken) portYIELD_FROM_ISR();
+#endif
+}
+
+/* ── Fast boot ───────────────────────────────────────────── */
+
+/* A zero that is off by the tolerance eats into the release hysteresis;
+ * at or above PRESSURE_RELEASE_THRESHOLD the press would never release */
+static_assert(LOADCELL_FAST_BOOT_TOLERANCE_G < PRESSURE_RELEASE_THRESHOLD / 2,
+              "LOADCELL_FAST_BOOT_TOLERANCE_G must be below half the release threshold");
+
+/* Short power-up with the saved zero instead of stabilize + tare.
+ * Valid if the unloaded plate still reads within tolerance of zero;
+ * otherwise loadcell_init() falls back to the full tare. */
+static bool fast_boot(int32_t savedOffset)
+{
+    LoadCell.setSamplesInUse(LOADCELL_SAMPLES);
+    LoadCell.start(LOADCELL_FAST_STABILIZE_MS, false);
+    LoadCell.setTareOffset(savedOffset);
+
+    float sum = 0.0f;
+    int   n   = 0;
+    unsigned long start = millis();
+    while (n < LOADCELL_FAST_BOOT_SAMPLES && millis() - start < LOADCELL_TARE_TIMEOUT_MS) {
+        if (LoadCell.update()) {
+            sum += LoadCell.getData();
+            n++;
+        }
+        delay(1);
+    }
+
+    return n == LOADCELL_FAST_BOOT_SAMPLES &&
+           fabsf(sum / n) <= LOADCELL_FAST_BOOT_TOLERANCE_G;
+}
+
+/* ── Tare ────────────────────────────────────────────────── */
+
+/* HX711_ADC doesn't expose the conversion itself; undoing calibration
+ * and tare recovers what it reports, which with one sample in use and
+ * the library's IGN_HIGH_SAMPLE = IGN_LOW_SAMPLE = 1 is the median of the
+ * last 3 conversions (see telemetry_frame.h) */
+static int32_t raw_counts(float grams)
+{
+    return (int32_t)lroundf(grams * LoadCell.getCalFactor()) +
+           (int32_t)LoadCell.getTareOffset();
+}
+
+static void tare_begin()
+{
+    int32_t maxNoise = (int32_t)lroundf(LOADCELL_TARE_MAX_NOISE_G * fabsf(LoadCell.getCalFactor()));
+    tare.start(LOADCELL_TARE_SAMPLES, maxNoise);
+    tareStartUs = (uint32_t)esp_timer_get_time();
+}
+
+/* Commit (or drop) a finished tare. @return the event to report */
+static SensorEvent tare_finish()
+{
+    if (tare.status() != TareEstimator::DONE) {
+        stats.tareFailures++;
+        return SensorEvent::TARE_FAILED;
+    }
+
+    LoadCell.setTareOffset(tare.offset());
+    stats.tares++;
+
+    /* Remember the new zero for the next fast boot */
+    settings_set_tare_offset(tare.offset());
+
+    /* Old history is relative to the previous zero */
+    filterChain.reset();
+    return SensorEvent::TARE_DONE;
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
 bool loadcell_init()
 {
+    Settings cfg;
+    settings_get(cfg);
+
+    sensorTask = xTaskGetCurrentTaskHandle();
+
     LoadCell.begin();
-    LoadCell.start(LOADCELL_STABILIZE_MS, true);
+    LoadCell.setCalFactor(cfg.calFactor);
+    loadcell_set_filter(cfg.filter);   /* saved by "set filter" */
 
-    if (LoadCell.getTareTimeoutFlag()) {
-        return false;
+    bool ok = true;
+    readoutActive = true;
+    if (LOADCELL_FAST_BOOT && cfg.tareValid) {
+        if (fast_boot(cfg.tareOffset)) {
+            Serial.println("loadcell: fast boot with saved zero");
+        } else {
+            /* Zero has moved (or something is on the plate): full tare */
+            Serial.println("loadcell: saved zero out of tolerance, taring");
+            ok = loadcell_do_tare();
+        }
+    } else {
+        /* Settle, then the same outlier-rejecting tare as at runtime (it
+         * stops after LOADCELL_TARE_SAMPLES instead of a fixed 2 s) */
+        LoadCell.setSamplesInUse(LOADCELL_SAMPLES);
+        LoadCell.start(LOADCELL_STABILIZE_MS, false);
+        ok = loadcell_do_tare();
     }
+    readoutActive = false;
 
-    LoadCell.setCalFactor(LOADCELL_CAL_FACTOR);
+    if (!ok) {
+        return false;
+    }
 
     /* Reduce smoothing for fast response.
      * Default is 16 samples (~1.6s lag at 10 SPS).
      * Use 1 for instant response (no averaging). */
     LoadCell.setSamplesInUse(LOADCELL_SAMPLES);
 
+    attachInterrupt(digitalPinToInterrupt(PIN_HX711_DT), drdy_isr, FALLING);
+
+#if LOADCELL_ACQ_MODE == LOADCELL_ACQ_POLL
+    lastPollWake = xTaskGetTickCount();
+#endif
+
     return true;
 }
 
-bool loadcell_read(float &pressure)
+void loadcell_wait()
 {
-    /* Handle pending tare request */
+#if LOADCELL_ACQ_MODE == LOADCELL_ACQ_IRQ
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOADCELL_IRQ_TIMEOUT_MS));
+#else
+    vTaskDelayUntil(&lastPollWake, pdMS_TO_TICKS(SENSOR_READ_INTERVAL_MS));
+#endif
+    stats.wakeups++;
+}
+
+bool loadcell_read(pressure_cg_t &pressure, uint32_t &timestampUs)
+{
+    PROF_SCOPE(LOADCELL_READ);
+    uint32_t startUs = (uint32_t)esp_timer_get_time();
+
+    /* Start a requested tare; it consumes the next conversions */
     if (tareRequested) {
-        loadcell_do_tare();
         tareRequested = false;
+        tare_begin();
     }
 
+    bool isNew = false;
     if (LoadCell.dataWaitingAsync()) {
-        if (LoadCell.updateAsync()) {
-            pressure = LoadCell.getData();
-            return true;
+        /* Edge time if the ISR saw it, otherwise the best we know */
+        bool     seen = drdySeen;
+        uint32_t edge = seen ? drdyTimestampUs : startUs;
+
+        readoutActive = true;
+        isNew = LoadCell.updateAsync();
+        readoutActive = false;
+        drdySeen      = false;
+
+        if (isNew && tare.active()) {
+            float grams = LoadCell.getData();
+            if (tare.add(raw_counts(grams)) != TareEstimator::COLLECTING) {
+                pendingEvent = tare_finish();
+            }
+            isNew = false;
+        } else if (isNew) {
+            if (filterPending) {
+                /* configure() only copies and clamps, so it can run locked */
+                portENTER_CRITICAL(&filterMux);
+                filterChain.configure(pendingFilter);
+                activeFilter  = filterChain.config();
+                filterPending = false;
+                portEXIT_CRITICAL(&filterMux);
+            }
+
+            float grams        = LoadCell.getData();
+            lastRaw.counts     = raw_counts(grams);
+            lastRaw.unfiltered = pressure_from_grams(grams);
+
+            pressure    = filterChain.apply(lastRaw.unfiltered);
+            timestampUs = edge;
+
+            uint32_t latency = (uint32_t)esp_timer_get_time() - edge;
+            stats.samples++;
+            stats.lastLatencyUs = latency;
+            if (latency > stats.maxLatencyUs) stats.maxLatencyUs = latency;
         }
+    } else {
+        stats.emptyWakeups++;
+    }
+
+    /* No conversions (HX711 unplugged?): give up rather than stay CALIBRATING */
+    if (tare.active() &&
+        (uint32_t)esp_timer_get_time() - tareStartUs > LOADCELL_TARE_TIMEOUT_MS * 1000UL) {
+        tare.fail();
+        pendingEvent = tare_finish();
     }
-    return false;
+
+    stats.busyUs += (uint32_t)esp_timer_get_time() - startUs;
+    statsOut.write(stats);
+    return isNew;
+}
+
+void loadcell_get_raw(LoadcellRaw &raw)
+{
+    raw = lastRaw;
 }
 
 void loadcell_request_tare()
@@ -50,13 +264,47 @@ void loadcell_request_tare()
     tareRequested = true;
 }
 
-void loadcell_do_tare()
+SensorEvent loadcell_take_event()
 {
-    LoadCell.tareNoDelay();
-    /* Wait for tare to complete */
+    SensorEvent ev = pendingEvent;
+    pendingEvent   = SensorEvent::NONE;
+    return ev;
+}
+
+bool loadcell_do_tare()
+{
+    tare_begin();
     unsigned long start = millis();
-    while (!LoadCell.getTareStatus() && (millis() - start < LOADCELL_TARE_TIMEOUT_MS)) {
-        LoadCell.update();
-        delay(10);
+    while (tare.active() && millis() - start < LOADCELL_TARE_TIMEOUT_MS) {
+        if (LoadCell.update()) {
+            tare.add(raw_counts(LoadCell.getData()));
+        }
+        delay(1);
     }
+    if (tare.active()) tare.fail();
+
+    bool ok = tare_finish() == SensorEvent::TARE_DONE;
+    statsOut.write(stats);
+    return ok;
+}
+
+void loadcell_set_filter(const FilterConfig &cfg)
+{
+    portENTER_CRITICAL(&filterMux);
+    pendingFilter = cfg;
+    filterPending = true;
+    portEXIT_CRITICAL(&filterMux);
+}
+
+FilterConfig loadcell_get_filter()
+{
+    portENTER_CRITICAL(&filterMux);
+    FilterConfig cfg = filterPending ? pendingFilter : activeFilter;
+    portEXIT_CRITICAL(&filterMux);
+    return cfg;
+}
+
+void loadcell_get_stats(LoadcellStats &out)
+{
+    if (!statsOut.read(out)) out = LoadcellStats{};
 }
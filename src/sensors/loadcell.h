@@ -1,30 +1,103 @@
 #ifndef LOADCELL_H
 #define LOADCELL_H
 
+#include <stdint.h>
+#include "../logic/app_state.h"
+#include "../logic/pressure.h"
+#include "filter.h"
+
+/**
+ * Acquisition counters, used to compare LOADCELL_ACQ_POLL vs LOADCELL_ACQ_IRQ.
+ */
+struct LoadcellStats {
+    uint32_t samples;        // Conversions read
+    uint32_t wakeups;        // Sensor task wakeups (poll slots or DRDY edges)
+    uint32_t emptyWakeups;   // Wakeups that found no conversion ready
+    uint32_t lastLatencyUs;  // DRDY edge → value available, last sample
+    uint32_t maxLatencyUs;   // DRDY edge → value available, worst case
+    uint32_t busyUs;         // CPU time spent inside loadcell_read()
+    uint32_t tares;          // Tares committed
+    uint32_t tareFailures;   // Tares rejected (noise or timeout)
+};
+
 /**
  * Initialize the HX711 load cell.
- * Blocks during stabilization (~2 seconds).
+ * Blocks for LOADCELL_STABILIZE_MS plus a tare (~1.3 s), or only briefly
+ * when the tare offset saved in settings still reads as zero
+ * (LOADCELL_FAST_BOOT).
+ * Must be called from the task that will call loadcell_wait(), since
+ * in IRQ mode that task is the one notified by the DRDY interrupt.
  * @return true on success, false on timeout/error
  */
 bool loadcell_init();
 
+/**
+ * Block until the next conversion may be ready.
+ * IRQ mode: waits for the DT falling edge (at most LOADCELL_IRQ_TIMEOUT_MS).
+ * Poll mode: sleeps until the next SENSOR_READ_INTERVAL_MS slot.
+ */
+void loadcell_wait();
+
 /**
  * Non-blocking read of the load cell.
- * Call this periodically from the sensor task.
- * @param[out] pressure  Filled with current reading if data is available
+ * Call this from the sensor task after loadcell_wait(). The reading has
+ * already passed through the filter chain (see loadcell_set_filter()).
+ * While a tare is in progress conversions feed the tare instead and no
+ * reading is returned; check loadcell_take_event() for its outcome.
+ * @param[out] pressure     Filled with current reading (centigrams) if available
+ * @param[out] timestampUs  DRDY edge time of that conversion (esp_timer µs)
  * @return true if a new reading was obtained
  */
-bool loadcell_read(float &pressure);
+bool loadcell_read(pressure_cg_t &pressure, uint32_t &timestampUs);
+
+/**
+ * The HX711 reading behind the last successful loadcell_read(), before
+ * the filter chain. Sensor task only.
+ */
+struct LoadcellRaw {
+    int32_t       counts;       // HX711_ADC's value in counts: median of the last 3 conversions
+    pressure_cg_t unfiltered;   // Tared, calibrated, not yet filtered
+};
+
+void loadcell_get_raw(LoadcellRaw &raw);
 
 /**
  * Tare (zero) the load cell.
- * Can be called from any task — the actual tare happens on next read cycle.
+ * Can be called from any task. The tare starts on the next read cycle and
+ * then advances one conversion per loadcell_read() (LOADCELL_TARE_SAMPLES
+ * in total), so the sensor task never blocks on it.
  */
 void loadcell_request_tare();
 
 /**
- * Execute the tare operation (blocking, ~1s).
+ * Event raised by the last loadcell_read(), if any (TARE_DONE or
+ * TARE_FAILED). Reading it clears it. Sensor task only.
+ */
+SensorEvent loadcell_take_event();
+
+/**
+ * Tare synchronously (blocking, ~1s), using the same estimator.
+ * Only for loadcell_init(), before the sensor loop runs.
+ * @return true if the tare completed within LOADCELL_TARE_TIMEOUT_MS
+ */
+bool loadcell_do_tare();
+
+/**
+ * Change the filter chain applied to every reading (safe from any task).
+ * Takes effect on the next sample and restarts the filter history.
+ */
+void loadcell_set_filter(const FilterConfig &cfg);
+
+/**
+ * Current filter chain configuration (safe from any task; a pending
+ * loadcell_set_filter() is reported as current).
+ */
+FilterConfig loadcell_get_filter();
+
+/**
+ * Copy the acquisition counters as of the last loadcell_read() (safe from
+ * any task: published through a SeqLock, so the copy is never torn).
  */
-void loadcell_do_tare();
+void loadcell_get_stats(LoadcellStats &stats);
 
 #endif /* LOADCELL_H */
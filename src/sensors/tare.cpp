@@ -0,0 +1,81 @@
+#include "tare.h"
+
+#include <stdlib.h>
+
+/* Outlier cut-off in robust standard deviations */
+static constexpr int32_t TARE_REJECT_SIGMA = 3;
+
+/* Insertion sort; at most TARE_SAMPLES_MAX values */
+static void sort_counts(int32_t *v, uint8_t n)
+{
+    for (uint8_t i = 1; i < n; i++) {
+        int32_t x = v[i];
+        int8_t  j = (int8_t)i - 1;
+        while (j >= 0 && v[j] > x) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = x;
+    }
+}
+
+void TareEstimator::start(uint8_t samples, int32_t maxNoiseCounts)
+{
+    if (samples < 3) samples = 3;
+    if (samples > TARE_SAMPLES_MAX) samples = TARE_SAMPLES_MAX;
+    target_   = samples;
+    count_    = 0;
+    maxNoise_ = maxNoiseCounts;
+    status_   = COLLECTING;
+}
+
+void TareEstimator::fail()
+{
+    status_ = FAILED;
+}
+
+TareEstimator::Status TareEstimator::add(int32_t counts)
+{
+    if (status_ != COLLECTING) return status_;
+
+    buf_[count_++] = counts;
+    if (count_ == target_) finish();
+    return status_;
+}
+
+void TareEstimator::finish()
+{
+    int32_t sorted[TARE_SAMPLES_MAX];
+    int32_t dev[TARE_SAMPLES_MAX];
+    for (uint8_t i = 0; i < count_; i++) sorted[i] = buf_[i];
+    sort_counts(sorted, count_);
+    int32_t med = sorted[count_ / 2];
+
+    for (uint8_t i = 0; i < count_; i++) dev[i] = abs(buf_[i] - med);
+    sort_counts(dev, count_);
+    int32_t mad = dev[count_ / 2];
+
+    /* σ ≈ 1.4826·MAD for Gaussian noise */
+    noise_ = (mad * 3 + 1) / 2;
+    if (noise_ > maxNoise_) {
+        status_ = FAILED;
+        return;
+    }
+
+    /* At least one count of slack so a perfectly quiet input keeps every sample */
+    int32_t limit = noise_ * TARE_REJECT_SIGMA;
+    if (limit < 1) limit = 1;
+
+    int64_t sum  = 0;
+    int32_t kept = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (abs(buf_[i] - med) <= limit) {
+            sum += buf_[i];
+            kept++;
+        }
+    }
+
+    /* kept ≥ half the samples by construction of the MAD */
+    offset_ = (int32_t)((sum + (sum >= 0 ? kept / 2 : -kept / 2)) / kept);
+    status_ = DONE;
+}
@@ -0,0 +1,59 @@
+#ifndef TARE_H
+#define TARE_H
+
+#include <stdint.h>
+
+/**
+ * Incremental tare: fed one raw conversion at a time from the sensor
+ * task instead of blocking it until the zero is found.
+ *
+ * After `samples` conversions the median and MAD (median absolute
+ * deviation) are taken; conversions further than TARE_REJECT_SIGMA
+ * robust standard deviations from the median are discarded and the rest
+ * averaged into the new offset. If the spread itself is above the noise
+ * limit the plate was disturbed while taring and the result is FAILED.
+ *
+ * Free of hardware dependencies so the simulator uses the same code.
+ */
+
+static constexpr uint8_t TARE_SAMPLES_MAX = 32;
+
+class TareEstimator {
+public:
+    enum Status : uint8_t { IDLE, COLLECTING, DONE, FAILED };
+
+    /**
+     * Begin collecting.
+     * @param samples         Conversions to gather (clamped to 3..TARE_SAMPLES_MAX)
+     * @param maxNoiseCounts  Largest robust σ (HX711 counts) still accepted
+     */
+    void start(uint8_t samples, int32_t maxNoiseCounts);
+
+    /** Abandon the current attempt (e.g. timeout); status becomes FAILED */
+    void fail();
+
+    /** Add one raw conversion. @return status after this sample */
+    Status add(int32_t counts);
+
+    Status  status() const { return status_; }
+    bool    active() const { return status_ == COLLECTING; }
+
+    /** New zero in HX711 counts, valid once status() is DONE */
+    int32_t offset() const { return offset_; }
+
+    /** Robust σ of the last completed attempt, in counts */
+    int32_t noise() const { return noise_; }
+
+private:
+    void finish();
+
+    int32_t buf_[TARE_SAMPLES_MAX];
+    uint8_t target_   = 0;
+    uint8_t count_    = 0;
+    int32_t maxNoise_ = 0;
+    int32_t offset_   = 0;
+    int32_t noise_    = 0;
+    Status  status_   = IDLE;
+};
+
+#endif /* TARE_H */
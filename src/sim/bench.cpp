@@ -0,0 +1,123 @@
+#include "bench.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+static uint64_t read_cycles() { return __rdtsc(); }
+#else
+#define BENCH_HAVE_TSC 0
+static uint64_t read_cycles() { return 0; }
+#endif
+
+static const int      MAX_BENCHES   = 64;
+static const uint64_t MIN_RUN_NS    = 50ULL * 1000 * 1000;   /* 50 ms per timed run */
+static const uint64_t MAX_ITERS     = 1ULL << 32;
+
+struct BenchEntry {
+    const char *name;
+    BenchFn     fn;
+};
+
+struct BenchMetric {
+    const char *key;
+    double      value;
+};
+
+static BenchEntry benches[MAX_BENCHES];
+static int        benchCount = 0;
+
+/* bench_report() values of the benchmark being run */
+static const int  MAX_METRICS = 4;
+static BenchMetric metrics[MAX_METRICS];
+static int         metricCount = 0;
+
+/* Results are folded in here so bench bodies can't be optimized away */
+volatile uint64_t benchSink = 0;
+
+BenchRegistrar::BenchRegistrar(const char *name, BenchFn fn)
+{
+    if (benchCount < MAX_BENCHES) {
+        benches[benchCount++] = { name, fn };
+    }
+}
+
+void bench_report(const char *key, double value)
+{
+    for (int i = 0; i < metricCount; i++) {
+        if (strcmp(metrics[i].key, key) == 0) {
+            metrics[i].value = value;
+            return;
+        }
+    }
+    if (metricCount < MAX_METRICS) {
+        metrics[metricCount++] = { key, value };
+    }
+}
+
+static uint64_t time_run(BenchFn fn, uint64_t iters, uint64_t *cycles)
+{
+    auto     start  = std::chrono::steady_clock::now();
+    uint64_t cstart = read_cycles();
+    benchSink += fn(iters);
+    *cycles = read_cycles() - cstart;
+    auto end = std::chrono::steady_clock::now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+int bench_run_all(const char *filter, BenchFormat format)
+{
+    int  run  = 0;
+    bool json = format == BenchFormat::JSON;
+
+    if (json) {
+        printf("{\"tsc\": %s, \"benchmarks\": [", BENCH_HAVE_TSC ? "true" : "false");
+    } else {
+        printf("%-36s %12s %12s %12s\n", "benchmark", "iterations", "ns/op",
+               BENCH_HAVE_TSC ? "tsc/op" : "");
+    }
+
+    for (int i = 0; i < benchCount; i++) {
+        const BenchEntry &b = benches[i];
+        if (filter && !strstr(b.name, filter)) continue;
+
+        metricCount = 0;
+
+        /* Warm up, then grow the iteration count until a run is long enough */
+        uint64_t iters  = 1;
+        uint64_t cycles = 0;
+        uint64_t ns     = time_run(b.fn, iters, &cycles);
+        while (ns < MIN_RUN_NS && iters < MAX_ITERS) {
+            iters *= (ns < MIN_RUN_NS / 100) ? 10 : 2;
+            ns = time_run(b.fn, iters, &cycles);
+        }
+
+        double nsPerOp  = (double)ns / (double)iters;
+        double tscPerOp = (double)cycles / (double)iters;
+
+        /* Names are C identifiers (BENCH macro), so no JSON escaping needed */
+        if (json) {
+            printf("%s\n  {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f",
+                   run ? "," : "", b.name, (unsigned long long)iters, nsPerOp);
+            if (BENCH_HAVE_TSC) printf(", \"tsc_per_op\": %.1f", tscPerOp);
+            for (int m = 0; m < metricCount; m++) {
+                printf(", \"%s\": %.4g", metrics[m].key, metrics[m].value);
+            }
+            printf("}");
+        } else {
+            printf("%-36s %12llu %12.2f", b.name, (unsigned long long)iters, nsPerOp);
+            if (BENCH_HAVE_TSC) printf(" %12.1f", tscPerOp);
+            for (int m = 0; m < metricCount; m++) {
+                printf("  %s=%.4g", metrics[m].key, metrics[m].value);
+            }
+            printf("\n");
+        }
+        run++;
+    }
+
+    if (json) printf("\n]}\n");
+    return run;
+}
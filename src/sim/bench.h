@@ -0,0 +1,59 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+/**
+ * Tiny host micro-benchmark registry for the native build.
+ *
+ * A benchmark body runs its operation `iters` times and returns a value
+ * derived from the work (folded into a sink so the optimizer can't drop
+ * it). The harness scales `iters` until one run takes long enough to
+ * time reliably and reports wall-clock ns (and TSC ticks on x86) per operation.
+ *
+ *   BENCH(ring_push_pop) {
+ *       uint64_t acc = 0;
+ *       for (uint64_t i = 0; i < iters; i++) { ... acc += ...; }
+ *       return acc;
+ *   }
+ */
+
+typedef uint64_t (*BenchFn)(uint64_t iters);
+
+enum class BenchFormat : uint8_t {
+    TEXT,   // aligned table for reading
+    JSON,   // one object, for diffing results in review / CI
+};
+
+struct BenchRegistrar {
+    BenchRegistrar(const char *name, BenchFn fn);
+};
+
+#define BENCH(name)                                                   \
+    static uint64_t bench_##name(uint64_t iters);                     \
+    static BenchRegistrar benchRegistrar_##name(#name, bench_##name); \
+    static uint64_t bench_##name(uint64_t iters)
+
+/**
+ * Attach an extra result to the benchmark that is running, e.g. a count
+ * per operation (`key` must be a string literal). Reported next to ns/op;
+ * the last value reported wins.
+ */
+void bench_report(const char *key, double value);
+
+/**
+ * Run every registered benchmark whose name contains `filter`
+ * (nullptr = all) and print the results to stdout, one line per
+ * benchmark (TEXT) or as a single JSON document:
+ *
+ *   {"tsc": true, "benchmarks": [
+ *     {"name": "filter_default", "iterations": 4194304, "ns_per_op": 11.9, "tsc_per_op": 35.2},
+ *     ...]}
+ *
+ * Values passed to bench_report() are added to the benchmark's object.
+ *
+ * @return number of benchmarks run
+ */
+int bench_run_all(const char *filter, BenchFormat format = BenchFormat::TEXT);
+
+#endif /* BENCH_H */
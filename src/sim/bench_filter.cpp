@@ -0,0 +1,47 @@
+/* Filter chain cost per sample, per stage and for the default chain */
+
+#include "bench.h"
+#include "../sensors/filter.h"
+
+static const int SWEEP = 1024;
+static pressure_cg_t noisy[SWEEP];
+
+static bool init_noisy()
+{
+    uint32_t lcg = 12345;
+    for (int i = 0; i < SWEEP; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        int32_t noise = (int32_t)(lcg >> 20) - 2048;            /* ±20 g */
+        noisy[i] = (i % 256 < 128 ? 500000 : 0) + noise;        /* 5 kg square wave */
+    }
+    return true;
+}
+static bool noisyReady = init_noisy();
+
+static uint64_t run_chain(const FilterConfig &cfg, uint64_t iters)
+{
+    FilterChain chain;
+    chain.configure(cfg);
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        acc += (uint64_t)chain.apply(noisy[i % SWEEP]);
+    }
+    return acc;
+}
+
+static FilterConfig only(uint8_t median, uint16_t alphaQ15, bool kalman)
+{
+    FilterConfig cfg = filter_default_config();
+    cfg.medianWindow  = median;
+    cfg.iirAlphaQ15   = alphaQ15;
+    cfg.kalmanEnabled = kalman;
+    return cfg;
+}
+
+BENCH(filter_passthrough) { return run_chain(only(0, 0, false), iters); }
+BENCH(filter_median3)     { return run_chain(only(3, 0, false), iters); }
+BENCH(filter_median5)     { return run_chain(only(5, 0, false), iters); }
+BENCH(filter_median7)     { return run_chain(only(7, 0, false), iters); }
+BENCH(filter_iir)         { return run_chain(only(0, 16384, false), iters); }
+BENCH(filter_kalman)      { return run_chain(only(0, 0, true), iters); }
+BENCH(filter_default)     { return run_chain(filter_default_config(), iters); }
@@ -0,0 +1,300 @@
+/* The whole sample → pixel chain, stage by stage and end to end:
+ * filtering as in loadcell_read(), PressTimer, the snapshot handoff,
+ * ui_handle_command(), the arc/timer text tick and an LVGL render into
+ * the simulated (offscreen) framebuffer. Run with `bench --json pipeline`
+ * and diff against the previous result to catch per-frame regressions.
+ * The display_* benches compare the draw buffer layouts (config.h
+ * DISPLAY_RENDER_MODE) on the same screen. */
+
+#include "bench.h"
+#include "sim_clock.h"
+#include "sim_display.h"
+#include "../config.h"
+#include "../display/lv_setup.h"
+#include "../logic/app_snapshot.h"
+#include "../logic/press_timer.h"
+#include "../sensors/filter.h"
+#include "../ui/ui_format.h"
+#include "../ui/ui_screen.h"
+#include "../ui/ui_theme.h"
+#include "../ui/ui_update.h"
+#include "../audio/buzzer.h"
+
+#include <lvgl.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+/* 80 SPS readings in grams: a 5 kg press every 256 samples, ±20 g noise */
+static const int      SWEEP     = 1024;
+static const uint32_t SAMPLE_US = 12500;
+static float grams[SWEEP];
+
+static bool init_grams()
+{
+    uint32_t lcg = 4242;
+    for (int i = 0; i < SWEEP; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        float noise = (float)((int32_t)(lcg >> 20) - 2048) / 100.0f;
+        grams[i] = (i % 256 < 128 ? 5000.0f : 0.0f) + noise;
+    }
+    return true;
+}
+static bool gramsReady = init_grams();
+
+/* ── Fixture ─────────────────────────────────────────────── */
+
+/* The main screen, built once: LVGL can only be initialized once per
+ * process (bench mode never creates a UI-enabled SimApp) */
+static QueueHandle_t actionQueue = nullptr;
+
+static void ui_ready()
+{
+    if (actionQueue) return;
+    actionQueue = xQueueCreate(QUEUE_SIZE, sizeof(UserAction));
+    lv_setup_init();
+    ui_theme_init();
+    ui_screen_create(actionQueue);
+    buzzer_init();
+    lv_refr_now(nullptr);
+}
+
+/* A PressTimer past its boot tare, i.e. accepting pressure */
+struct LogicFixture {
+    AppSnapshotChannel snapshot;
+    PressTimer         timer;
+
+    LogicFixture() : timer(snapshot, nullptr)
+    {
+        timer.processSensorEvent(SensorEvent::TARE_DONE);
+        timer.publish();
+    }
+};
+
+/* ── Stages ──────────────────────────────────────────────── */
+
+/* loadcell_read() minus the HX711 I/O: grams → fixed point → default chain */
+BENCH(pipeline_sample_filter)
+{
+    FilterChain chain;
+    chain.configure(filter_default_config());
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        acc += (uint64_t)chain.apply(pressure_from_grams(grams[i % SWEEP]));
+    }
+    return acc;
+}
+
+BENCH(pipeline_press_timer)
+{
+    LogicFixture logic;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        logic.timer.processPressure(pressure_from_grams(grams[i % SWEEP]),
+                                    (uint32_t)(i * SAMPLE_US));
+        acc += (uint64_t)logic.timer.getState();
+    }
+    return acc;
+}
+
+/* PressTimer::publish() → seqlock → the UI task's read + diff */
+BENCH(pipeline_snapshot_handoff)
+{
+    LogicFixture logic;
+    AppSnapshot  shown = {}, next;
+    UICommand    changes[APP_SNAPSHOT_MAX_CHANGES];
+    uint64_t     acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        logic.timer.processPressure(pressure_from_grams(grams[i % SWEEP]),
+                                    (uint32_t)(i * SAMPLE_US));
+        logic.timer.publish();
+        if (logic.snapshot.read(next)) {
+            acc  += app_snapshot_diff(&shown, next, changes);
+            shown = next;
+        }
+    }
+    return acc;
+}
+
+BENCH(pipeline_ui_pressure_command)
+{
+    ui_ready();
+    UICommand cmd = {};
+    cmd.type = UICommandType::UPDATE_PRESSURE;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        cmd.pressure = pressure_from_grams(grams[i % SWEEP]);
+        ui_handle_command(cmd);
+        acc += (uint64_t)cmd.pressure;
+    }
+    return acc;
+}
+
+/* The text half of ui_arc_tick(): countdown and overtime */
+BENCH(pipeline_format_timer)
+{
+    uint64_t acc = 0;
+    char buf[16];
+    for (uint64_t i = 0; i < iters; i++) {
+        int secs = (int)(i % 600);
+        ui_format_timer(secs, (i & 1024) != 0, buf, sizeof(buf));
+        acc += (uint8_t)buf[0];
+    }
+    return acc;
+}
+
+/* One ui_arc_tick() per frame while TIMING (arc every frame, text once a second) */
+BENCH(pipeline_arc_tick)
+{
+    ui_ready();
+    UICommand start = {};
+    start.type = UICommandType::UPDATE_TIMER_START;
+    UICommand cmd = {};
+    cmd.type  = UICommandType::UPDATE_STATE;
+    cmd.state = AppState::TIMING;
+    ui_handle_command(cmd);
+
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        /* Restart before the countdown runs out so it never stops moving */
+        if (i % 256 == 0) {
+            start.timerStartUs = (uint32_t)sim_clock_us();
+            ui_handle_command(start);
+        }
+        sim_clock_advance_us(UI_REFRESH_PERIOD_MS * 1000ULL);
+        ui_arc_tick();
+        acc += i;
+    }
+
+    cmd.state = AppState::IDLE;
+    ui_handle_command(cmd);
+    lv_refr_now(nullptr);
+    return acc;
+}
+
+/* Render + flush of the whole screen, e.g. the alert background flip */
+BENCH(pipeline_render_full_screen)
+{
+    ui_ready();
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(nullptr);
+        acc += lv_color_to32(sim_display_framebuffer()[i % (SCREEN_WIDTH * SCREEN_HEIGHT)]);
+    }
+    return acc;
+}
+
+/* Render + flush after a pressure change: the common IDLE frame */
+BENCH(pipeline_render_pressure)
+{
+    ui_ready();
+    UICommand cmd = {};
+    cmd.type = UICommandType::UPDATE_PRESSURE;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        cmd.pressure = pressure_from_grams(grams[i % SWEEP]);
+        ui_handle_command(cmd);
+        lv_refr_now(nullptr);
+        acc += (uint64_t)cmd.pressure;
+    }
+    return acc;
+}
+
+/* ── Draw buffer layouts ─────────────────────────────────── */
+
+/* Frames of one kind rendered with a given DISPLAY_RENDER_MODE layout:
+ * a full-screen invalidation (the alert background flip) or a pressure
+ * change. Reports how many rectangles and pixels each frame sent. */
+static uint64_t run_layout(uint32_t lines, uint8_t count, uint8_t mode,
+                           bool fullScreen, uint64_t iters)
+{
+    ui_ready();
+    sim_display_set_buffers(lines, count, mode);
+    lv_refr_now(nullptr);
+
+    FrameStats before, after;
+    lv_setup_get_frame_stats(before);
+
+    UICommand cmd = {};
+    cmd.type = UICommandType::UPDATE_PRESSURE;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        if (fullScreen) {
+            lv_obj_invalidate(lv_scr_act());
+        } else {
+            cmd.pressure = pressure_from_grams(grams[i % SWEEP]);
+            ui_handle_command(cmd);
+        }
+        lv_refr_now(nullptr);
+        acc += (uint64_t)cmd.pressure;
+    }
+
+    lv_setup_get_frame_stats(after);
+    uint32_t frames = after.frames - before.frames;
+    if (frames) {
+        bench_report("flushes_per_frame", (double)(after.flushes - before.flushes) / frames);
+        bench_report("px_per_frame", (double)(after.flushedPx - before.flushedPx) / frames);
+    }
+
+    sim_display_set_buffers(DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+                            ? DISPLAY_BUF_LINES : SCREEN_HEIGHT,
+                            DISPLAY_BUF_COUNT, DISPLAY_RENDER_MODE);
+    lv_refr_now(nullptr);
+    return acc;
+}
+
+BENCH(display_full_screen_partial20x2)  { return run_layout(20, 2, DISPLAY_RENDER_PARTIAL, true, iters); }
+BENCH(display_full_screen_partial20x1)  { return run_layout(20, 1, DISPLAY_RENDER_PARTIAL, true, iters); }
+BENCH(display_full_screen_partial60x2)  { return run_layout(60, 2, DISPLAY_RENDER_PARTIAL, true, iters); }
+BENCH(display_full_screen_partial240x1) { return run_layout(240, 1, DISPLAY_RENDER_PARTIAL, true, iters); }
+BENCH(display_full_screen_direct)       { return run_layout(240, 1, DISPLAY_RENDER_DIRECT, true, iters); }
+BENCH(display_full_screen_full)         { return run_layout(240, 1, DISPLAY_RENDER_FULL, true, iters); }
+
+BENCH(display_pressure_partial20x2)     { return run_layout(20, 2, DISPLAY_RENDER_PARTIAL, false, iters); }
+BENCH(display_pressure_partial60x2)     { return run_layout(60, 2, DISPLAY_RENDER_PARTIAL, false, iters); }
+BENCH(display_pressure_direct)          { return run_layout(240, 1, DISPLAY_RENDER_DIRECT, false, iters); }
+BENCH(display_pressure_full)            { return run_layout(240, 1, DISPLAY_RENDER_FULL, false, iters); }
+
+/* ── End to end ──────────────────────────────────────────── */
+
+/* One conversion all the way to pixels, as the three tasks would run it
+ * if every sample got its own frame (the worst case at 80 SPS) */
+BENCH(pipeline_sample_to_pixel)
+{
+    ui_ready();
+    LogicFixture logic;
+    FilterChain  chain;
+    chain.configure(filter_default_config());
+
+    AppSnapshot shown = {}, next;
+    bool        haveShown = false;
+    UICommand   changes[APP_SNAPSHOT_MAX_CHANGES];
+    uint64_t    acc = 0;
+
+    for (uint64_t i = 0; i < iters; i++) {
+        sim_clock_advance_us(SAMPLE_US);
+
+        pressure_cg_t p = chain.apply(pressure_from_grams(grams[i % SWEEP]));
+        logic.timer.processPressure(p, (uint32_t)sim_clock_us());
+        logic.timer.tick();
+        logic.timer.publish();
+
+        if (logic.snapshot.read(next)) {
+            size_t n = app_snapshot_diff(haveShown ? &shown : nullptr, next, changes);
+            for (size_t k = 0; k < n; k++) ui_handle_command(changes[k]);
+            shown     = next;
+            haveShown = true;
+            acc += n;
+        }
+        ui_arc_tick();
+        lv_refr_now(nullptr);
+    }
+
+    /* Leave the shared screen as the other benches expect it */
+    UICommand idle = {};
+    idle.type  = UICommandType::UPDATE_STATE;
+    idle.state = AppState::IDLE;
+    ui_handle_command(idle);
+    lv_refr_now(nullptr);
+    return acc;
+}
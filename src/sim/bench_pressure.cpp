@@ -0,0 +1,112 @@
+/* Per-sample pressure math: the previous float pipeline (kept here as
+ * the reference) vs the fixed-point path in logic/pressure.h. */
+
+#include "bench.h"
+#include "../logic/pressure.h"
+#include "../ui/ui_format.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Sweep of readings in grams covering noise, light and heavy presses */
+static const int SWEEP = 256;
+static float         sweepGrams[SWEEP];
+static pressure_cg_t sweepCg[SWEEP];
+
+static bool init_sweep()
+{
+    for (int i = 0; i < SWEEP; i++) {
+        sweepGrams[i] = (float)(i - 16) * 157.3f;
+        sweepCg[i]    = pressure_from_grams(sweepGrams[i]);
+    }
+    return true;
+}
+static bool sweepReady = init_sweep();
+
+/* ── Reference float path ────────────────────────────────── */
+
+static int float_display_value(float grams)
+{
+    return (int)roundf(grams / 10.0f);
+}
+
+static void float_format_pressure(float grams, bool showBar, char *buf, size_t len)
+{
+    if (showBar) {
+        float forceN = (grams / 1000.0f) * 9.80665f;
+        float areaM2 = (PRESS_AREA_WIDTH_MM * PRESS_AREA_HEIGHT_MM) * 1e-6f;
+        float mbar = forceN / (areaM2 * 1e5f) * 1000.0f;
+        if (mbar > -0.05f && mbar < 0.05f) mbar = 0.0f;
+        snprintf(buf, len, "%.1f", mbar);
+    } else {
+        snprintf(buf, len, "%.2f", grams / 1000.0f);
+    }
+    if (strncmp(buf, "-0.00", 5) == 0) {
+        strcpy(buf, "0.00");
+    }
+}
+
+/* ── Benchmarks ──────────────────────────────────────────── */
+
+BENCH(pressure_display_value_float)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        acc += (uint64_t)float_display_value(sweepGrams[i % SWEEP]);
+    }
+    return acc;
+}
+
+BENCH(pressure_display_value_fixed)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        acc += (uint64_t)pressure_to_centikg(sweepCg[i % SWEEP]);
+    }
+    return acc;
+}
+
+BENCH(pressure_format_kg_float)
+{
+    uint64_t acc = 0;
+    char buf[16];
+    for (uint64_t i = 0; i < iters; i++) {
+        float_format_pressure(sweepGrams[i % SWEEP], false, buf, sizeof(buf));
+        acc += (uint8_t)buf[0];
+    }
+    return acc;
+}
+
+BENCH(pressure_format_kg_fixed)
+{
+    uint64_t acc = 0;
+    char buf[16];
+    for (uint64_t i = 0; i < iters; i++) {
+        ui_format_pressure(sweepCg[i % SWEEP], false, buf, sizeof(buf));
+        acc += (uint8_t)buf[0];
+    }
+    return acc;
+}
+
+BENCH(pressure_format_mbar_float)
+{
+    uint64_t acc = 0;
+    char buf[16];
+    for (uint64_t i = 0; i < iters; i++) {
+        float_format_pressure(sweepGrams[i % SWEEP], true, buf, sizeof(buf));
+        acc += (uint8_t)buf[0];
+    }
+    return acc;
+}
+
+BENCH(pressure_format_mbar_fixed)
+{
+    uint64_t acc = 0;
+    char buf[16];
+    for (uint64_t i = 0; i < iters; i++) {
+        ui_format_pressure(sweepCg[i % SWEEP], true, buf, sizeof(buf));
+        acc += (uint8_t)buf[0];
+    }
+    return acc;
+}
@@ -0,0 +1,69 @@
+/* Sensor → logic handoff: SPSC ring vs FreeRTOS queue.
+ * One sample produced and consumed per operation, plus a batched
+ * variant matching logicTask's drain pattern. */
+
+#include "bench.h"
+#include "../config.h"
+#include "../logic/app_state.h"
+#include "../util/spsc_ring.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+static SpscRing<SensorData, SENSOR_RING_SIZE> ring;
+
+BENCH(handoff_spsc_ring)
+{
+    uint64_t acc = 0;
+    SensorData in = { 0, 0, true, 0, 0, SensorEvent::NONE }, out = {};
+    for (uint64_t i = 0; i < iters; i++) {
+        in.timestampUs = (uint32_t)i;
+        ring.push(in);
+        ring.pop(out);
+        acc += out.timestampUs;
+    }
+    return acc;
+}
+
+BENCH(handoff_spsc_ring_batch8)
+{
+    uint64_t acc = 0;
+    SensorData in = { 0, 0, true, 0, 0, SensorEvent::NONE }, out[LOGIC_BATCH_SIZE] = {};
+    for (uint64_t i = 0; i < iters; i += LOGIC_BATCH_SIZE) {
+        for (int k = 0; k < LOGIC_BATCH_SIZE; k++) {
+            in.timestampUs = (uint32_t)(i + k);
+            ring.push(in);
+        }
+        size_t n = ring.popBatch(out, LOGIC_BATCH_SIZE);
+        acc += out[n - 1].timestampUs;
+    }
+    return acc;
+}
+
+BENCH(handoff_freertos_queue)
+{
+    static QueueHandle_t queue = xQueueCreate(SENSOR_RING_SIZE, sizeof(SensorData));
+    uint64_t acc = 0;
+    SensorData in = { 0, 0, true, 0, 0, SensorEvent::NONE }, out = {};
+    for (uint64_t i = 0; i < iters; i++) {
+        in.timestampUs = (uint32_t)i;
+        xQueueSend(queue, &in, 0);
+        xQueueReceive(queue, &out, 0);
+        acc += out.timestampUs;
+    }
+    return acc;
+}
+
+BENCH(handoff_freertos_overwrite)
+{
+    static QueueHandle_t queue = xQueueCreate(1, sizeof(SensorData));
+    uint64_t acc = 0;
+    SensorData in = { 0, 0, true, 0, 0, SensorEvent::NONE }, out = {};
+    for (uint64_t i = 0; i < iters; i++) {
+        in.timestampUs = (uint32_t)i;
+        xQueueOverwrite(queue, &in);
+        xQueueReceive(queue, &out, 0);
+        acc += out.timestampUs;
+    }
+    return acc;
+}
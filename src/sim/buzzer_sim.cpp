@@ -0,0 +1,31 @@
+#include "../audio/buzzer.h"
+#include "sim_buzzer.h"
+
+static bool     on      = false;
+static uint32_t onCount = 0;
+
+void buzzer_init()
+{
+    on = false;
+}
+
+void buzzer_on()
+{
+    if (!on) onCount++;
+    on = true;
+}
+
+void buzzer_off()
+{
+    on = false;
+}
+
+bool sim_buzzer_is_on()
+{
+    return on;
+}
+
+uint32_t sim_buzzer_on_count()
+{
+    return onCount;
+}
@@ -0,0 +1,140 @@
+#include "shim/freertos/FreeRTOS.h"
+#include "shim/freertos/queue.h"
+#include "shim/freertos/task.h"
+#include "sim_clock.h"
+
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+/* ── Queues ──────────────────────────────────────────────── */
+
+struct SimQueue {
+    std::mutex           lock;
+    std::vector<uint8_t> storage;
+    UBaseType_t          length;
+    UBaseType_t          itemSize;
+    UBaseType_t          head  = 0;   /* next item to receive */
+    UBaseType_t          count = 0;
+};
+
+static void wait_virtual(TickType_t wait)
+{
+    if (wait != 0 && wait != portMAX_DELAY) {
+        sim_clock_advance_us((uint64_t)wait * (1000000ULL / configTICK_RATE_HZ));
+    }
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    SimQueue *q = new SimQueue;
+    q->length   = length;
+    q->itemSize = itemSize;
+    q->storage.resize((size_t)length * itemSize);
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q)
+{
+    delete q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait)
+{
+    {
+        std::lock_guard<std::mutex> guard(q->lock);
+        if (q->count < q->length) {
+            UBaseType_t tail = (q->head + q->count) % q->length;
+            memcpy(&q->storage[(size_t)tail * q->itemSize], item, q->itemSize);
+            q->count++;
+            return pdTRUE;
+        }
+    }
+    wait_virtual(wait);
+    return pdFALSE;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t q, const void *item, TickType_t wait)
+{
+    return xQueueSend(q, item, wait);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void *item)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    if (q->count == q->length) {
+        /* Only meaningful for length-1 queues, as on FreeRTOS */
+        q->head = (q->head + 1) % q->length;
+        q->count--;
+    }
+    UBaseType_t tail = (q->head + q->count) % q->length;
+    memcpy(&q->storage[(size_t)tail * q->itemSize], item, q->itemSize);
+    q->count++;
+    return pdTRUE;
+}
+
+static BaseType_t take(QueueHandle_t q, void *item, TickType_t wait, bool remove)
+{
+    {
+        std::lock_guard<std::mutex> guard(q->lock);
+        if (q->count > 0) {
+            memcpy(item, &q->storage[(size_t)q->head * q->itemSize], q->itemSize);
+            if (remove) {
+                q->head = (q->head + 1) % q->length;
+                q->count--;
+            }
+            return pdTRUE;
+        }
+    }
+    wait_virtual(wait);
+    return pdFALSE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait)
+{
+    return take(q, item, wait, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void *item, TickType_t wait)
+{
+    return take(q, item, wait, false);
+}
+
+BaseType_t xQueueReset(QueueHandle_t q)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    q->head  = 0;
+    q->count = 0;
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    return q->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    return q->length - q->count;
+}
+
+/* ── Task timing ─────────────────────────────────────────── */
+
+TickType_t xTaskGetTickCount()
+{
+    return (TickType_t)(sim_clock_us() / (1000000ULL / configTICK_RATE_HZ));
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    wait_virtual(ticks);
+}
+
+void vTaskDelayUntil(TickType_t *previousWake, TickType_t period)
+{
+    TickType_t next = *previousWake + period;
+    sim_clock_set_us((uint64_t)next * (1000000ULL / configTICK_RATE_HZ));
+    *previousWake = next;
+}
@@ -0,0 +1,146 @@
+#include "shim/LittleFS.h"
+
+#include <map>
+#include <set>
+#include <string.h>
+#include <vector>
+
+/* min_spiffs.csv: 128 kB data partition */
+#define SIM_FS_TOTAL_BYTES (128 * 1024)
+
+SimLittleFS LittleFS;
+
+static std::map<std::string, std::vector<uint8_t>> files;
+static std::set<std::string>                       dirs = { "/" };
+
+static std::string parent_of(const std::string &path)
+{
+    size_t slash = path.rfind('/');
+    return slash == 0 || slash == std::string::npos ? "/" : path.substr(0, slash);
+}
+
+/* ── File ────────────────────────────────────────────────── */
+
+size_t File::read(uint8_t *buf, size_t len)
+{
+    auto it = files.find(path_);
+    if (!open_ || isDir_ || it == files.end() || pos_ >= it->second.size()) return 0;
+
+    size_t n = it->second.size() - pos_;
+    if (n > len) n = len;
+    memcpy(buf, it->second.data() + pos_, n);
+    pos_ += n;
+    return n;
+}
+
+size_t File::write(const uint8_t *buf, size_t len)
+{
+    auto it = files.find(path_);
+    if (!open_ || isDir_ || it == files.end()) return 0;
+
+    std::vector<uint8_t> &data = it->second;
+    if (data.size() < pos_ + len) data.resize(pos_ + len);
+    memcpy(data.data() + pos_, buf, len);
+    pos_ += len;
+    return len;
+}
+
+bool File::seek(uint32_t pos)
+{
+    if (!open_ || pos > size()) return false;
+    pos_ = pos;
+    return true;
+}
+
+size_t File::size() const
+{
+    auto it = files.find(path_);
+    return it == files.end() ? 0 : it->second.size();
+}
+
+const char *File::name() const
+{
+    size_t slash = path_.rfind('/');
+    return path_.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+File File::openNextFile()
+{
+    File entry;
+    if (!open_ || !isDir_) return entry;
+
+    size_t index = 0;
+    for (const auto &f : files) {
+        if (parent_of(f.first) != path_) continue;
+        if (index++ < next_) continue;
+        next_++;
+        entry.open_ = true;
+        entry.path_ = f.first;
+        return entry;
+    }
+    return entry;
+}
+
+/* ── Filesystem ──────────────────────────────────────────── */
+
+bool SimLittleFS::format()
+{
+    files.clear();
+    dirs = { "/" };
+    return true;
+}
+
+File SimLittleFS::open(const char *path, const char *mode)
+{
+    File f;
+    f.path_ = path;
+
+    if (dirs.count(f.path_)) {
+        f.open_  = strcmp(mode, "r") == 0;
+        f.isDir_ = true;
+        return f;
+    }
+    if (!dirs.count(parent_of(f.path_))) return f;
+
+    auto it = files.find(f.path_);
+    if (mode[0] == 'r') {
+        if (it == files.end()) return f;
+    } else if (mode[0] == 'w') {
+        files[f.path_].clear();
+    } else if (mode[0] == 'a') {
+        f.pos_ = files[f.path_].size();
+    } else {
+        return f;
+    }
+    f.open_ = true;
+    return f;
+}
+
+bool SimLittleFS::exists(const char *path) const
+{
+    return files.count(path) || dirs.count(path);
+}
+
+bool SimLittleFS::remove(const char *path)
+{
+    return files.erase(path) > 0;
+}
+
+bool SimLittleFS::mkdir(const char *path)
+{
+    if (!dirs.count(parent_of(path))) return false;
+    dirs.insert(path);
+    return true;
+}
+
+size_t SimLittleFS::usedBytes() const
+{
+    size_t used = 0;
+    for (const auto &f : files) used += f.second.size();
+    return used;
+}
+
+size_t SimLittleFS::totalBytes() const
+{
+    return SIM_FS_TOTAL_BYTES;
+}
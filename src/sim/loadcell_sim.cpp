@@ -0,0 +1,173 @@
+#include "../sensors/loadcell.h"
+#include "../sensors/tare.h"
+#include "sim_loadcell.h"
+#include "sim_clock.h"
+#include "../config.h"
+
+#include <math.h>
+
+static SimPressureFn source    = nullptr;
+static void         *sourceCtx = nullptr;
+
+static uint32_t periodUs       = 100000;   /* 10 SPS */
+static uint64_t nextConvUs     = 0;
+static float    tareOffset     = 0.0f;
+static bool     tareRequested  = false;
+
+static TareEstimator tare;
+static uint64_t      tareStartUs  = 0;
+static SensorEvent   pendingEvent = SensorEvent::NONE;
+
+static FilterChain   filterChain;
+static LoadcellStats stats = {};
+static LoadcellRaw   lastRaw = {};
+
+/* ── Simulation control ──────────────────────────────────── */
+
+void sim_loadcell_set_source(SimPressureFn fn, void *ctx)
+{
+    source    = fn;
+    sourceCtx = ctx;
+}
+
+void sim_loadcell_set_rate(uint32_t samplesPerSec)
+{
+    periodUs = 1000000UL / samplesPerSec;
+}
+
+uint64_t sim_loadcell_next_conversion_us()
+{
+    return nextConvUs;
+}
+
+void sim_loadcell_reset()
+{
+    nextConvUs    = sim_clock_us() + periodUs;
+    tareOffset    = 0.0f;
+    tareRequested = false;
+    tare          = TareEstimator();
+    pendingEvent  = SensorEvent::NONE;
+    stats         = {};
+    filterChain.reset();
+}
+
+static float gross_at(uint64_t t)
+{
+    return source ? source(t, sourceCtx) : 0.0f;
+}
+
+/* Same bookkeeping as loadcell.cpp; counts are gross grams × cal factor */
+static void tare_begin()
+{
+    tare.start(LOADCELL_TARE_SAMPLES, (int32_t)lroundf(LOADCELL_TARE_MAX_NOISE_G * LOADCELL_CAL_FACTOR));
+    tareStartUs = sim_clock_us();
+}
+
+static SensorEvent tare_finish()
+{
+    if (tare.status() != TareEstimator::DONE) {
+        stats.tareFailures++;
+        return SensorEvent::TARE_FAILED;
+    }
+    tareOffset = tare.offset() / LOADCELL_CAL_FACTOR;
+    stats.tares++;
+    filterChain.reset();
+    return SensorEvent::TARE_DONE;
+}
+
+/* ── loadcell.h ──────────────────────────────────────────── */
+
+bool loadcell_init()
+{
+    sim_loadcell_reset();
+    tareOffset = gross_at(sim_clock_us());
+    return true;
+}
+
+void loadcell_wait()
+{
+    /* Equivalent of the DRDY interrupt: sleep until the next conversion */
+    sim_clock_set_us(nextConvUs);
+    stats.wakeups++;
+}
+
+bool loadcell_read(pressure_cg_t &pressure, uint32_t &timestampUs)
+{
+    if (tareRequested) {
+        tareRequested = false;
+        tare_begin();
+    }
+
+    uint64_t now = sim_clock_us();
+    if (now < nextConvUs) {
+        stats.emptyWakeups++;
+        if (tare.active() && now - tareStartUs > LOADCELL_TARE_TIMEOUT_MS * 1000ULL) {
+            tare.fail();
+            pendingEvent = tare_finish();
+        }
+        return false;
+    }
+
+    /* Report the newest conversion; older ones were overwritten in the ADC */
+    uint64_t conv = nextConvUs + ((now - nextConvUs) / periodUs) * periodUs;
+    nextConvUs    = conv + periodUs;
+
+    float   gross  = gross_at(conv);
+    int32_t counts = (int32_t)lroundf(gross * LOADCELL_CAL_FACTOR);
+    if (tare.active()) {
+        if (tare.add(counts) != TareEstimator::COLLECTING) {
+            pendingEvent = tare_finish();
+        }
+        return false;
+    }
+
+    lastRaw.counts     = counts;
+    lastRaw.unfiltered = pressure_from_grams(gross - tareOffset);
+
+    pressure    = filterChain.apply(lastRaw.unfiltered);
+    timestampUs = (uint32_t)conv;
+
+    stats.samples++;
+    stats.lastLatencyUs = (uint32_t)(now - conv);
+    if (stats.lastLatencyUs > stats.maxLatencyUs) stats.maxLatencyUs = stats.lastLatencyUs;
+    return true;
+}
+
+void loadcell_get_raw(LoadcellRaw &raw)
+{
+    raw = lastRaw;
+}
+
+void loadcell_request_tare()
+{
+    tareRequested = true;
+}
+
+SensorEvent loadcell_take_event()
+{
+    SensorEvent ev = pendingEvent;
+    pendingEvent   = SensorEvent::NONE;
+    return ev;
+}
+
+bool loadcell_do_tare()
+{
+    tareOffset = gross_at(sim_clock_us());
+    filterChain.reset();
+    return true;
+}
+
+void loadcell_set_filter(const FilterConfig &cfg)
+{
+    filterChain.configure(cfg);   /* single-threaded: apply immediately */
+}
+
+FilterConfig loadcell_get_filter()
+{
+    return filterChain.config();
+}
+
+void loadcell_get_stats(LoadcellStats &out)
+{
+    out = stats;
+}
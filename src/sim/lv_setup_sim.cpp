@@ -0,0 +1,194 @@
+#include "../display/lv_setup.h"
+#include "../config.h"
+#include "sim_display.h"
+
+#include <string.h>
+
+/* ── Framebuffer + LVGL internals ──────────────────────── */
+
+static lv_color_t framebuffer[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+/* Room for two full frames, so every DISPLAY_RENDER_MODE can be tried
+ * at runtime (sim_display_set_buffers()); the device allocates only what
+ * its mode needs */
+static lv_color_t buf1[SCREEN_WIDTH * SCREEN_HEIGHT];
+static lv_color_t buf2[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t      disp_drv;
+static lv_disp_t         *disp = nullptr;
+static lv_indev_drv_t     indev_drv;
+static uint32_t           bufLines = 0;
+static uint32_t           bufCount = 0;
+
+static FrameStats frameStats = {};
+static bool       idle       = false;
+
+static int16_t touchX = 0, touchY = 0;
+static bool    touchPressed = false;
+
+/* Injected points are already in screen pixels; the mapping is only kept */
+static TouchCal touchCal = touch_cal_default();
+
+/* ── Display flush callback ──────────────────────────────── */
+
+static void push_area(const lv_area_t &a, const lv_color_t *src, uint32_t stride)
+{
+    uint32_t w = (a.x2 - a.x1 + 1);
+    uint32_t h = (a.y2 - a.y1 + 1);
+
+    for (uint32_t y = 0; y < h; y++) {
+        memcpy(&framebuffer[(a.y1 + y) * SCREEN_WIDTH + a.x1], src + y * stride,
+               w * sizeof(lv_color_t));
+    }
+
+    frameStats.flushes++;
+    frameStats.flushedPx += w * h;
+}
+
+static void sim_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    if (drv->direct_mode) {
+        /* Same as the device: the dirty areas, once, after the last one */
+        if (lv_disp_flush_is_last(drv)) {
+            lv_disp_t *d = _lv_refr_get_disp_refreshing();
+            for (uint16_t i = 0; i < d->inv_p; i++) {
+                if (d->inv_area_joined[i]) continue;
+                const lv_area_t &a = d->inv_areas[i];
+                push_area(a, color_p + a.y1 * SCREEN_WIDTH + a.x1, SCREEN_WIDTH);
+            }
+        }
+    } else {
+        push_area(*area, color_p, area->x2 - area->x1 + 1);
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+static void sim_monitor_cb(lv_disp_drv_t *drv, uint32_t timeMs, uint32_t px)
+{
+    frameStats.frames++;
+    frameStats.lastFrameMs   = timeMs;
+    frameStats.totalFrameMs += timeMs;
+    if (timeMs > frameStats.maxFrameMs) frameStats.maxFrameMs = timeMs;
+}
+
+/* ── Touch read callback ─────────────────────────────────── */
+
+static void sim_touch_read_cb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+    data->point.x = touchX;
+    data->point.y = touchY;
+    data->state   = touchPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+void lv_setup_init()
+{
+    lv_init();
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res  = SCREEN_WIDTH;
+    disp_drv.ver_res  = SCREEN_HEIGHT;
+    disp_drv.flush_cb   = sim_flush_cb;
+    disp_drv.monitor_cb = sim_monitor_cb;
+    disp_drv.draw_buf   = &draw_buf;
+    sim_display_set_buffers(DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+                            ? DISPLAY_BUF_LINES : SCREEN_HEIGHT,
+                            DISPLAY_BUF_COUNT, DISPLAY_RENDER_MODE);
+    disp = lv_disp_drv_register(&disp_drv);
+
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type    = LV_INDEV_TYPE_POINTER;
+    indev_drv.read_cb = sim_touch_read_cb;
+    lv_indev_drv_register(&indev_drv);
+}
+
+uint32_t lv_setup_update()
+{
+    return lv_timer_handler();
+}
+
+void lv_setup_set_idle(bool enable)
+{
+    if (enable == idle) return;
+    idle = enable;
+
+    if (enable) {
+        lv_timer_pause(indev_drv.read_timer);
+    } else {
+        lv_timer_resume(indev_drv.read_timer);
+        lv_timer_ready(indev_drv.read_timer);
+    }
+}
+
+bool lv_setup_touch_active()
+{
+    return touchPressed || lv_disp_get_inactive_time(nullptr) < UI_TOUCH_HOLD_MS;
+}
+
+void lv_setup_set_touch_cal(const TouchCal &cal)
+{
+    touchCal = cal;
+}
+
+void lv_setup_get_touch_cal(TouchCal &cal)
+{
+    cal = touchCal;
+}
+
+bool lv_setup_touch_raw(uint16_t &x, uint16_t &y)
+{
+    x = (uint16_t)touchX;
+    y = (uint16_t)touchY;
+    return touchPressed;
+}
+
+void lv_setup_get_frame_stats(FrameStats &stats)
+{
+    stats = frameStats;
+    stats.bufLines = bufLines;
+    stats.bufCount = bufCount;
+}
+
+void lv_setup_get_mem_stats(LvMemStats &stats)
+{
+    /* Single-threaded here: sample on demand */
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    stats = { mon.total_size, mon.total_size - mon.free_size, mon.max_used,
+              mon.free_biggest_size, mon.frag_pct };
+}
+
+const lv_color_t* sim_display_framebuffer() { return framebuffer; }
+
+void sim_touch_set(int16_t x, int16_t y, bool pressed)
+{
+    touchX       = x;
+    touchY       = y;
+    touchPressed = pressed;
+}
+
+bool sim_display_set_buffers(uint32_t lines, uint8_t count, uint8_t renderMode)
+{
+    bool screenSized = renderMode != DISPLAY_RENDER_PARTIAL;
+    if (lines == 0 || lines > SCREEN_HEIGHT || count < 1 || count > 2 ||
+        renderMode > DISPLAY_RENDER_FULL || (screenSized && lines != SCREEN_HEIGHT) ||
+        (renderMode == DISPLAY_RENDER_DIRECT && count != 1)) {
+        return false;
+    }
+
+    bufLines = lines;
+    bufCount = count;
+    lv_disp_draw_buf_init(&draw_buf, buf1, count > 1 ? buf2 : nullptr, SCREEN_WIDTH * lines);
+    disp_drv.direct_mode  = renderMode == DISPLAY_RENDER_DIRECT;
+    disp_drv.full_refresh = renderMode == DISPLAY_RENDER_FULL;
+
+    /* Before lv_setup_init() registers the driver there's nothing to update */
+    if (disp) {
+        lv_disp_drv_update(disp, &disp_drv);
+        lv_obj_invalidate(lv_scr_act());
+    }
+    return true;
+}
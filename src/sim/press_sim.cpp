@@ -0,0 +1,221 @@
+#include "press_sim.h"
+#include "sim_app.h"
+#include "sim_clock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+
+/* ── SimMetric ───────────────────────────────────────────── */
+
+double SimMetric::percentile(double p) const
+{
+    if (values.empty()) return 0.0;
+    std::vector<double> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    size_t idx = (size_t)((p / 100.0) * (double)(sorted.size() - 1) + 0.5);
+    return sorted[idx];
+}
+
+double SimMetric::mean() const
+{
+    if (values.empty()) return 0.0;
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    return sum / (double)values.size();
+}
+
+double SimMetric::max() const
+{
+    return values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+}
+
+/* ── Transition capture ──────────────────────────────────── */
+
+struct Transition {
+    uint64_t timeUs;
+    AppState state;
+    uint32_t lateUs;   /* ALERT: PressTimer::alertLatenessUs() */
+};
+
+struct Capture {
+    std::vector<Transition> transitions;
+    SimApp                 *app;
+};
+
+static void capture_transition(const UICommand &cmd, uint64_t nowUs, void *ctx)
+{
+    if (cmd.type != UICommandType::UPDATE_STATE) return;
+    Capture *cap = static_cast<Capture *>(ctx);
+    cap->transitions.push_back({ nowUs, cmd.state, cap->app->timer().alertLatenessUs() });
+}
+
+static const char *state_name(AppState s)
+{
+    switch (s) {
+        case AppState::CALIBRATING: return "CALIBRATING";
+        case AppState::IDLE:        return "IDLE";
+        case AppState::TIMING:      return "TIMING";
+        case AppState::ALERT:       return "ALERT";
+    }
+    return "?";
+}
+
+/* Index of the last press with onUs <= t, or -1 */
+static long press_at(const std::vector<TruePress> &truth, uint64_t t)
+{
+    auto it = std::upper_bound(truth.begin(), truth.end(), t,
+                               [](uint64_t v, const TruePress &p) { return v < p.onUs; });
+    return (long)(it - truth.begin()) - 1;
+}
+
+/* ── Simulation ──────────────────────────────────────────── */
+
+PressSimReport press_sim_run(SimPressureFn source, void *ctx,
+                             const std::vector<TruePress> &truth,
+                             uint64_t durationUs,
+                             const PressSimOptions &opts)
+{
+    PressSimReport r;
+    Capture        cap;
+
+    auto wallStart = std::chrono::steady_clock::now();
+
+    sim_clock_reset();
+    sim_loadcell_set_source(source, ctx);
+
+    SimApp app(false);
+    cap.app = &app;
+    app.setUiObserver(capture_transition, &cap);
+    app.setTelemetrySink(opts.telemetry);
+
+    /* Step the timer setting to the requested duration, as the operator would */
+    if (opts.timerSeconds > 0) {
+        while (app.timer().getTimerDuration() != opts.timerSeconds) {
+            int before = app.timer().getTimerDuration();
+            app.sendAction(before < opts.timerSeconds ? UserActionType::TIMER_INCREMENT
+                                                      : UserActionType::TIMER_DECREMENT);
+            app.runUntil(sim_clock_us() + UI_REFRESH_PERIOD_MS * 1000ULL);
+            if (app.timer().getTimerDuration() == before) break;   /* clamped */
+        }
+    }
+    uint64_t timerUs = (uint64_t)app.timer().getTimerDuration() * 1000000ULL;
+
+    app.runUntil(durationUs);
+
+    r.suppressedEngages  = app.timer().getDetector().suppressedEngages();
+    r.suppressedReleases = app.timer().getDetector().suppressedReleases();
+    r.uiWakeups          = app.uiWakeups();
+
+    r.virtualUs   = durationUs;
+    r.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    /* ── Score transitions against ground truth ──────── */
+    std::vector<bool> detected(truth.size(), false);
+    std::vector<bool> alerted(truth.size(), false);
+    std::vector<bool> released(truth.size(), false);
+    AppState prev = AppState::IDLE;
+
+    for (const Transition &tr : cap.transitions) {
+        long   idx    = press_at(truth, tr.timeUs);
+        bool   inside = idx >= 0 && tr.timeUs < truth[idx].offUs;
+        double ms     = 0.0;
+        const char *verdict = "";
+
+        switch (tr.state) {
+            case AppState::TIMING:
+                if (!inside) {
+                    r.falseStarts++;
+                    verdict = "false start";
+                } else if (detected[idx]) {
+                    r.retriggers++;
+                    verdict = "retrigger";
+                } else {
+                    detected[idx] = true;
+                    ms = (double)(tr.timeUs - truth[idx].onUs) / 1000.0;
+                    r.detectLatencyMs.add(ms);
+                    verdict = "detect";
+                }
+                break;
+
+            case AppState::ALERT:
+                if (!inside) {
+                    /* Fired after the release (release detection lagging
+                     * behind the deadline): the operator has already
+                     * opened the press, so it is noise, not an alert */
+                    r.spuriousAlerts++;
+                    verdict = "spurious";
+                } else if (!alerted[idx]) {
+                    alerted[idx] = true;
+                    int64_t err = (int64_t)tr.timeUs - (int64_t)(truth[idx].onUs + timerUs);
+                    ms = (double)err / 1000.0;
+                    r.alertErrorMs.add(ms);
+                    r.alertLatenessMs.add((double)tr.lateUs / 1000.0);
+                    if (err < 0) r.earlyAlerts++;
+                    verdict = "alert";
+                }
+                break;
+
+            case AppState::IDLE:
+                if (prev == AppState::TIMING || prev == AppState::ALERT) {
+                    if (inside) {
+                        r.dropouts++;
+                        verdict = "dropout";
+                    } else if (idx >= 0 && !released[idx]) {
+                        released[idx] = true;
+                        ms = (double)(tr.timeUs - truth[idx].offUs) / 1000.0;
+                        r.releaseLatencyMs.add(ms);
+                        verdict = "release";
+                    }
+                }
+                break;
+
+            case AppState::CALIBRATING:
+                break;
+        }
+
+        if (opts.printEvents) {
+            printf("%10.3f  %-6s -> %-11s press=%-5ld %-11s %8.1f ms\n",
+                   (double)tr.timeUs / 1e6, state_name(prev), state_name(tr.state),
+                   idx, verdict, ms);
+        }
+        prev = tr.state;
+    }
+
+    for (size_t i = 0; i < truth.size(); i++) {
+        if (truth[i].offUs > durationUs) continue;   /* cut off by the end of the run */
+        r.presses++;
+        if (detected[i]) r.detected++; else r.missed++;
+        if (truth[i].offUs - truth[i].onUs > timerUs) {
+            r.alertsDue++;
+            if (!alerted[i]) r.alertsMissed++;
+        }
+    }
+
+    return r;
+}
+
+static void print_metric(const char *name, const SimMetric &m)
+{
+    printf("  %-22s n=%-6zu mean=%8.1f  p50=%8.1f  p95=%8.1f  p99=%8.1f  max=%8.1f ms\n",
+           name, m.count(), m.mean(), m.percentile(50), m.percentile(95),
+           m.percentile(99), m.max());
+}
+
+void press_sim_print(const PressSimReport &r)
+{
+    printf("presses %u  detected %u  missed %u  false starts %u  retriggers %u  dropouts %u\n",
+           r.presses, r.detected, r.missed, r.falseStarts, r.retriggers, r.dropouts);
+    printf("alerts due %u  missed %u  early %u  after release %u\n", r.alertsDue,
+           r.alertsMissed, r.earlyAlerts, r.spuriousAlerts);
+    printf("suppressed engages %u  releases %u\n", r.suppressedEngages, r.suppressedReleases);
+    printf("ui wakeups %u (%.1f/s)\n", r.uiWakeups,
+           r.virtualUs ? r.uiWakeups / ((double)r.virtualUs / 1e6) : 0.0);
+    print_metric("detection latency", r.detectLatencyMs);
+    print_metric("release latency", r.releaseLatencyMs);
+    print_metric("alert timing error", r.alertErrorMs);
+    print_metric("alert deadline late", r.alertLatenessMs);
+    printf("simulated %.1f h in %.2f s wall (%.0fx real time)\n",
+           (double)r.virtualUs / 3.6e9, r.wallSeconds,
+           r.wallSeconds > 0.0 ? ((double)r.virtualUs / 1e6) / r.wallSeconds : 0.0);
+}
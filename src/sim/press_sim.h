@@ -0,0 +1,67 @@
+#ifndef PRESS_SIM_H
+#define PRESS_SIM_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "sim_loadcell.h"
+#include "trace.h"
+
+/**
+ * Press-detection simulator: replays a pressure trace through the full
+ * sensor → logic → UI path (headless SimApp) on the virtual clock and
+ * scores every state transition against the ground-truth presses.
+ *
+ * Transitions are timed when the UI task dequeues them, i.e. what the
+ * operator would see.
+ */
+
+/** Running distribution of one metric (milliseconds) */
+struct SimMetric {
+    std::vector<double> values;
+
+    void   add(double v) { values.push_back(v); }
+    size_t count() const { return values.size(); }
+    double percentile(double p) const;   /* p in [0, 100] */
+    double mean() const;
+    double max() const;
+};
+
+struct PressSimReport {
+    uint32_t presses       = 0;   /* ground-truth presses */
+    uint32_t detected      = 0;   /* presses that produced TIMING */
+    uint32_t missed        = 0;   /* presses that never produced TIMING */
+    uint32_t falseStarts   = 0;   /* TIMING with no press on the plate */
+    uint32_t retriggers    = 0;   /* extra TIMING entries within one press */
+    uint32_t dropouts      = 0;   /* IDLE while the press was still closed */
+    uint32_t alertsDue     = 0;   /* presses held longer than the timer */
+    uint32_t alertsMissed  = 0;
+    uint32_t earlyAlerts   = 0;   /* ALERT before onset + duration */
+    uint32_t spuriousAlerts = 0;  /* ALERT shown with the plate already open */
+    uint32_t suppressedEngages  = 0;   /* PressDetector: knocks that never became TIMING */
+    uint32_t suppressedReleases = 0;   /* PressDetector: dips that never became IDLE */
+    uint32_t uiWakeups     = 0;   /* UI task runs (see UI_ADAPTIVE_REFRESH) */
+
+    SimMetric detectLatencyMs;    /* press onset → TIMING shown */
+    SimMetric releaseLatencyMs;   /* press release → IDLE shown */
+    SimMetric alertErrorMs;       /* ALERT shown − (onset + duration) */
+    SimMetric alertLatenessMs;    /* ALERT queued − PressTimer's deadline */
+
+    uint64_t virtualUs = 0;
+    double   wallSeconds = 0.0;
+};
+
+struct PressSimOptions {
+    int  timerSeconds = 0;        /* 0 = firmware default */
+    bool printEvents  = false;    /* one line per state transition */
+    FILE *telemetry   = nullptr;  /* write the device telemetry stream here */
+};
+
+PressSimReport press_sim_run(SimPressureFn source, void *ctx,
+                             const std::vector<TruePress> &truth,
+                             uint64_t durationUs,
+                             const PressSimOptions &opts);
+
+void press_sim_print(const PressSimReport &report);
+
+#endif /* PRESS_SIM_H */
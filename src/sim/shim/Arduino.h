@@ -0,0 +1,48 @@
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+/**
+ * Minimal Arduino core for the native build: only what src/logic and
+ * src/ui use, backed by the virtual clock. Serial writes to stdout.
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../sim_clock.h"
+
+#define IRAM_ATTR
+
+inline unsigned long millis() { return (unsigned long)(sim_clock_us() / 1000ULL); }
+inline unsigned long micros() { return (unsigned long)sim_clock_us(); }
+inline void delay(uint32_t ms) { sim_clock_advance_us((uint64_t)ms * 1000ULL); }
+
+/* HardwareSerial, enough for the diagnostics reports and the console
+ * (nobody types on the host: there is never input) */
+struct SimSerial {
+    int printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vprintf(fmt, ap);
+        va_end(ap);
+        return n;
+    }
+    int print(const char *s) { return fputs(s, stdout) >= 0 ? (int)strlen(s) : 0; }
+    int println(const char *s = "") { return print(s) + print("\n"); }
+    int available() { return 0; }
+    int read() { return -1; }
+};
+
+inline SimSerial Serial;
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+#endif /* SIM_ARDUINO_H */
@@ -0,0 +1,59 @@
+#ifndef SIM_LITTLEFS_H
+#define SIM_LITTLEFS_H
+
+/**
+ * In-memory LittleFS for the native build: the subset of the ESP32 core's
+ * fs::FS / fs::File API that storage/ uses. Writes go straight to RAM, so
+ * a test can lay out any on-flash state (empty or torn files) by hand.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+class File {
+public:
+    File() = default;
+
+    explicit operator bool() const { return open_; }
+
+    size_t read(uint8_t *buf, size_t len);
+    size_t write(const uint8_t *buf, size_t len);
+    bool   seek(uint32_t pos);
+    size_t size() const;
+    void   close() { open_ = false; }
+
+    /** Last path component, as the ESP32 core 2.x returns it */
+    const char *name() const;
+
+    /** Next entry of a directory opened with LittleFS.open() */
+    File openNextFile();
+
+private:
+    friend class SimLittleFS;
+
+    bool        open_  = false;
+    bool        isDir_ = false;
+    std::string path_;
+    size_t      pos_   = 0;
+    size_t      next_  = 0;   /* directory entries already returned */
+};
+
+class SimLittleFS {
+public:
+    bool begin(bool formatOnFail = false) { return true; }
+    bool format();
+
+    /** mode "r", "w" (truncate) or "a" (append); "r" on a directory lists it */
+    File open(const char *path, const char *mode = "r");
+    bool exists(const char *path) const;
+    bool remove(const char *path);
+    bool mkdir(const char *path);
+
+    size_t usedBytes() const;
+    size_t totalBytes() const;
+};
+
+extern SimLittleFS LittleFS;
+
+#endif /* SIM_LITTLEFS_H */
@@ -0,0 +1,10 @@
+#ifndef SIM_ESP_TIMER_H
+#define SIM_ESP_TIMER_H
+
+#include <stdint.h>
+
+#include "../sim_clock.h"
+
+inline int64_t esp_timer_get_time() { return (int64_t)sim_clock_us(); }
+
+#endif /* SIM_ESP_TIMER_H */
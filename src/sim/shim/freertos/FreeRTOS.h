@@ -0,0 +1,28 @@
+#ifndef SIM_FREERTOS_H
+#define SIM_FREERTOS_H
+
+/**
+ * FreeRTOS types and macros for the native build. Time is the virtual
+ * clock at a 1 kHz tick, like the ESP32 Arduino configuration.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define configTICK_RATE_HZ  1000
+#define portTICK_PERIOD_MS  (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY       ((TickType_t)0xFFFFFFFFUL)
+
+#define pdFALSE   ((BaseType_t)0)
+#define pdTRUE    ((BaseType_t)1)
+#define pdPASS    pdTRUE
+#define pdFAIL    pdFALSE
+
+#define pdMS_TO_TICKS(ms) \
+    ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000ULL))
+
+#endif /* SIM_FREERTOS_H */
@@ -0,0 +1,30 @@
+#ifndef SIM_FREERTOS_QUEUE_H
+#define SIM_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+/**
+ * FreeRTOS queue API on the host (mutex-protected copy-in/copy-out, the
+ * same cost structure as the real queue's critical section).
+ *
+ * The simulator is single-threaded, so a call that would block instead
+ * advances the virtual clock by its timeout and fails; portMAX_DELAY on
+ * an empty/full queue fails immediately.
+ */
+
+typedef struct SimQueue *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void          vQueueDelete(QueueHandle_t queue);
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t wait);
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t wait);
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait);
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t wait);
+BaseType_t xQueueReset(QueueHandle_t queue);
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue);
+
+#endif /* SIM_FREERTOS_QUEUE_H */
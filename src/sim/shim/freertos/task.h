@@ -0,0 +1,15 @@
+#ifndef SIM_FREERTOS_TASK_H
+#define SIM_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+/**
+ * Task timing API on the host. Delays advance the virtual clock; there
+ * is no scheduler, the simulator drives each "task" step explicitly.
+ */
+
+TickType_t xTaskGetTickCount();
+void       vTaskDelay(TickType_t ticks);
+void       vTaskDelayUntil(TickType_t *previousWake, TickType_t period);
+
+#endif /* SIM_FREERTOS_TASK_H */
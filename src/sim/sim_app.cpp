@@ -0,0 +1,148 @@
+#include "sim_app.h"
+#include "sim_clock.h"
+#include "sim_loadcell.h"
+
+#include "../display/lv_setup.h"
+#include "../sensors/loadcell.h"
+#include "../ui/ui_screen.h"
+#include "../ui/ui_theme.h"
+#include "../ui/ui_update.h"
+#include "../audio/buzzer.h"
+#include "../diag/telemetry_frame.h"
+
+SimApp::SimApp(bool withUi)
+    : withUi_(withUi)
+{
+    actionQueue_ = xQueueCreate(QUEUE_SIZE, sizeof(UserAction));
+
+    if (withUi_) {
+        lv_setup_init();
+        ui_theme_init();
+        ui_screen_create(actionQueue_);
+        buzzer_init();
+    }
+
+    loadcell_init();
+    timer_ = new PressTimer(snapshot_, actionQueue_);
+
+    /* Same initial timer display as logicTask (no saved settings here) */
+    timer_->setTimerDuration(TIMER_DEFAULT_SECONDS);
+    timer_->publish();
+
+    nextLogicUs_ = NEVER;
+    nextUiUs_    = sim_clock_us() + UI_REFRESH_PERIOD_MS * 1000ULL;
+}
+
+SimApp::~SimApp()
+{
+    delete timer_;
+    vQueueDelete(actionQueue_);
+}
+
+void SimApp::setUiObserver(UiObserver fn, void *ctx)
+{
+    observer_    = fn;
+    observerCtx_ = ctx;
+}
+
+void SimApp::sendAction(UserActionType type)
+{
+    UserAction action = { type };
+    xQueueSend(actionQueue_, &action, 0);
+    wakeLogic();
+}
+
+/* Equivalent of notify_logic(): run the logic task at the current time */
+void SimApp::wakeLogic()
+{
+    uint64_t now = sim_clock_us();
+    if (now < nextLogicUs_) nextLogicUs_ = now;
+}
+
+void SimApp::runUntil(uint64_t untilUs)
+{
+    for (;;) {
+        uint64_t nextConv = sim_loadcell_next_conversion_us();
+        uint64_t next     = nextConv;
+        if (nextLogicUs_ < next) next = nextLogicUs_;
+        if (nextUiUs_ < next)    next = nextUiUs_;
+        if (next > untilUs) break;
+
+        sim_clock_set_us(next);
+
+        /* Same-time events run in task-priority order: sensor, logic, UI */
+        if (next == nextConv) sensorStep();
+        if (next == nextLogicUs_) {
+            logicStep();
+        }
+        if (next == nextUiUs_) {
+            nextUiUs_ = next + uiStep() * 1000ULL;
+        }
+    }
+    sim_clock_set_us(untilUs);
+}
+
+/* One loop iteration of sensorTask (the conversion is already due) */
+void SimApp::sensorStep()
+{
+    SensorData data;
+    if (sensor_task_step(sensorRing_, data)) wakeLogic();
+}
+
+void SimApp::telemetrySample(const TelemetrySample &sample, void *ctx)
+{
+    SimApp *app = static_cast<SimApp *>(ctx);
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    size_t  len = telemetry_encode_sample(sample, app->telemetrySeq_++, 0, frame);
+    fwrite(frame, 1, len, app->telemetry_);
+}
+
+/* One loop iteration of logicTask */
+void SimApp::logicStep()
+{
+    /* No settings or cycle log here: nothing to persist */
+    LogicTaskHooks hooks = { telemetry_ ? telemetrySample : nullptr, nullptr, this };
+    LogicStepResult step = logic_task_step(*timer_, sensorRing_, actionQueue_, hooks);
+
+    /* Sleep until the next sample/action, or the deadline one-shot */
+    uint32_t atUs;
+    nextLogicUs_ = NEVER;
+    if (timer_->nextDeadline(atUs)) {
+        int32_t waitUs = (int32_t)(atUs - (uint32_t)sim_clock_us());
+        if (waitUs < 1) waitUs = 1;   /* as arm_deadline() */
+        nextLogicUs_ = sim_clock_us() + (uint64_t)waitUs;
+    }
+
+    /* Wake the UI task if it is sleeping with nothing to animate */
+    if (step.published && uiSleeping_) {
+        nextUiUs_ = sim_clock_us();
+    }
+}
+
+void SimApp::applyUiCommand(const UICommand &cmd, void *ctx)
+{
+    SimApp *app = static_cast<SimApp *>(ctx);
+    if (app->observer_) app->observer_(cmd, sim_clock_us(), app->observerCtx_);
+    if (app->withUi_) ui_handle_command(cmd);
+}
+
+/* One frame of uiTask. @return ms until the next frame */
+uint32_t SimApp::uiStep()
+{
+    uiWakeups_++;
+
+    ui_task_apply_snapshot(snapshot_, shown_, applyUiCommand, this);
+
+    bool     fullRate;
+    uint32_t nextTimerMs = UI_IDLE_MAX_SLEEP_MS;
+    if (withUi_) {
+        fullRate = ui_task_frame(nextTimerMs);
+        if (uxQueueMessagesWaiting(actionQueue_) > 0) wakeLogic();
+    } else {
+        /* Headless: the logic state stands in for what the UI would show */
+        fullRate = !UI_ADAPTIVE_REFRESH || timer_->getState() != AppState::IDLE;
+    }
+
+    uiSleeping_ = !fullRate;
+    return fullRate ? UI_REFRESH_PERIOD_MS : ui_task_idle_sleep_ms(nextTimerMs);
+}
@@ -0,0 +1,85 @@
+#ifndef SIM_APP_H
+#define SIM_APP_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../config.h"
+#include "../app/task_steps.h"
+#include "../logic/app_state.h"
+#include "../logic/press_timer.h"
+#include "../logic/app_snapshot.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+/**
+ * The HeatPress task graph from main.cpp, stepped cooperatively on the
+ * virtual clock: sensor conversions, logic ticks and UI frames each run
+ * at their configured time, in order, through the same per-iteration
+ * bodies as the tasks (app/task_steps.h). Feed pressure through
+ * sim_loadcell_set_source() before calling runUntil().
+ *
+ * With UI enabled the real ui_* code renders through LVGL into the
+ * simulated framebuffer. LVGL can only be initialized once per process,
+ * so only one UI-enabled SimApp may exist.
+ */
+class SimApp {
+public:
+    /** Called for every change the UI task applies (as a UICommand), when it applies it */
+    typedef void (*UiObserver)(const UICommand &cmd, uint64_t nowUs, void *ctx);
+
+    explicit SimApp(bool withUi);
+    ~SimApp();
+
+    /** Run all tasks up to (and including) virtual time untilUs */
+    void runUntil(uint64_t untilUs);
+
+    /** UI task wakeups so far (frames at full rate, fewer while idle) */
+    uint32_t uiWakeups() const { return uiWakeups_; }
+
+    /** Inject a button press, as the UI task would */
+    void sendAction(UserActionType type);
+
+    void setUiObserver(UiObserver fn, void *ctx);
+
+    /** Write the telemetry frames the device would stream (nullptr = off) */
+    void setTelemetrySink(FILE *f) { telemetry_ = f; }
+
+    PressTimer &timer() { return *timer_; }
+
+private:
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    void sensorStep();
+    void logicStep();
+    uint32_t uiStep();
+    void wakeLogic();
+
+    static void telemetrySample(const TelemetrySample &sample, void *ctx);
+    static void applyUiCommand(const UICommand &cmd, void *ctx);
+
+    bool          withUi_;
+    AppSnapshotChannel snapshot_;
+    QueueHandle_t actionQueue_;
+    PressTimer   *timer_;
+
+    SensorRing    sensorRing_;
+
+    uint64_t nextLogicUs_ = 0;       /* NEVER while nothing is pending */
+    uint64_t nextUiUs_    = 0;
+    bool     uiSleeping_  = false;   /* idle UI, woken early by UICommands */
+
+    uint32_t uiWakeups_   = 0;
+
+    /* Last snapshot the UI step applied */
+    UiShownState shown_;
+
+    FILE    *telemetry_    = nullptr;
+    uint16_t telemetrySeq_ = 0;
+
+    UiObserver observer_    = nullptr;
+    void      *observerCtx_ = nullptr;
+};
+
+#endif /* SIM_APP_H */
@@ -0,0 +1,12 @@
+#ifndef SIM_BUZZER_H
+#define SIM_BUZZER_H
+
+#include <stdint.h>
+
+/**
+ * Simulated LEDC buzzer (implements buzzer.h) — records state only.
+ */
+bool     sim_buzzer_is_on();
+uint32_t sim_buzzer_on_count();   /* number of off→on transitions */
+
+#endif /* SIM_BUZZER_H */
@@ -0,0 +1,27 @@
+#include "sim_clock.h"
+
+#include <atomic>
+
+static std::atomic<uint64_t> nowUs{0};
+
+uint64_t sim_clock_us()
+{
+    return nowUs.load(std::memory_order_relaxed);
+}
+
+void sim_clock_advance_us(uint64_t deltaUs)
+{
+    nowUs.fetch_add(deltaUs, std::memory_order_relaxed);
+}
+
+void sim_clock_set_us(uint64_t t)
+{
+    if (t > nowUs.load(std::memory_order_relaxed)) {
+        nowUs.store(t, std::memory_order_relaxed);
+    }
+}
+
+void sim_clock_reset()
+{
+    nowUs.store(0, std::memory_order_relaxed);
+}
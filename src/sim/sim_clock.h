@@ -0,0 +1,25 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * Virtual clock for the native (host) build.
+ * millis(), micros(), esp_timer_get_time() and the FreeRTOS tick count
+ * all read this clock, so a simulation advances exactly as far as the
+ * driver tells it to — independent of host speed.
+ */
+
+/** Current virtual time in microseconds since simulated boot */
+uint64_t sim_clock_us();
+
+/** Advance virtual time by deltaUs */
+void sim_clock_advance_us(uint64_t deltaUs);
+
+/** Jump to an absolute virtual time (must not go backwards) */
+void sim_clock_set_us(uint64_t nowUs);
+
+/** Reset to t = 0 (start of a new simulation run) */
+void sim_clock_reset();
+
+#endif /* SIM_CLOCK_H */
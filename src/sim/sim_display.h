@@ -0,0 +1,26 @@
+#ifndef SIM_DISPLAY_H
+#define SIM_DISPLAY_H
+
+#include <lvgl.h>
+#include <stdint.h>
+
+/**
+ * Simulated TFT + XPT2046 backend for the native build (implements
+ * lv_setup.h). Flushes land in an in-memory framebuffer; touch input is
+ * injected by the simulation driver.
+ */
+
+/** SCREEN_WIDTH × SCREEN_HEIGHT framebuffer, row-major */
+const lv_color_t* sim_display_framebuffer();
+
+/**
+ * Switch the draw buffer layout at runtime (the device fixes it at build
+ * time through DISPLAY_RENDER_MODE / DISPLAY_BUF_LINES / DISPLAY_BUF_COUNT).
+ * @return false for a layout the device build would reject
+ */
+bool sim_display_set_buffers(uint32_t lines, uint8_t count, uint8_t renderMode);
+
+/** Press or release the simulated touch panel at screen coordinates */
+void sim_touch_set(int16_t x, int16_t y, bool pressed);
+
+#endif /* SIM_DISPLAY_H */
@@ -0,0 +1,29 @@
+#ifndef SIM_LOADCELL_H
+#define SIM_LOADCELL_H
+
+#include <stdint.h>
+
+/**
+ * Simulated HX711 backend for the native build (implements loadcell.h).
+ * Conversions happen at a fixed rate on the virtual clock; each one
+ * asks the installed source for the force on the plate at that time.
+ */
+
+/**
+ * Pressure source: return the gross reading (grams, before tare) at
+ * virtual time timeUs.
+ */
+typedef float (*SimPressureFn)(uint64_t timeUs, void *ctx);
+
+void sim_loadcell_set_source(SimPressureFn fn, void *ctx);
+
+/** Conversion rate in samples per second (HX711: 10 or 80) */
+void sim_loadcell_set_rate(uint32_t samplesPerSec);
+
+/** Virtual time of the next conversion */
+uint64_t sim_loadcell_next_conversion_us();
+
+/** Forget tare offset and counters (start of a new run) */
+void sim_loadcell_reset();
+
+#endif /* SIM_LOADCELL_H */
@@ -0,0 +1,272 @@
+/**
+ * HeatPress — native (host) entry point
+ *
+ * Runs the real src/logic and src/ui code against the simulated
+ * backends in src/sim on a virtual clock.
+ *
+ *   program [demo]          one scripted press cycle, prints UI traffic
+ *   program sim [options]   replay a trace / synthetic cycles, score detection
+ *   program bench [--json] [filter]
+ *                           host micro-benchmarks (JSON for regression diffs)
+ */
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "press_sim.h"
+#include "sim_app.h"
+#include "sim_buzzer.h"
+#include "sim_clock.h"
+#include "sim_loadcell.h"
+#include "trace.h"
+#include "../sensors/loadcell.h"
+
+static const char *state_name(AppState s)
+{
+    switch (s) {
+        case AppState::CALIBRATING: return "CALIBRATING";
+        case AppState::IDLE:        return "IDLE";
+        case AppState::TIMING:      return "TIMING";
+        case AppState::ALERT:       return "ALERT";
+    }
+    return "?";
+}
+
+/* ── demo ────────────────────────────────────────────────── */
+
+/* 5 kg on the plate from t = 2 s to t = 25 s */
+static float demo_pressure(uint64_t timeUs, void *)
+{
+    return (timeUs >= 2000000ULL && timeUs < 25000000ULL) ? 5000.0f : 0.0f;
+}
+
+static void demo_observer(const UICommand &cmd, uint64_t nowUs, void *)
+{
+    double t = (double)nowUs / 1e6;
+    switch (cmd.type) {
+        case UICommandType::UPDATE_PRESSURE:
+            printf("%8.3f  pressure  %.2f g\n", t, (double)cmd.pressure / PRESSURE_CG_PER_GRAM);
+            break;
+        case UICommandType::UPDATE_TIMER:
+            printf("%8.3f  timer     %d s\n", t, cmd.timerSeconds);
+            break;
+        case UICommandType::UPDATE_STATE:
+            printf("%8.3f  state     %s\n", t, state_name(cmd.state));
+            break;
+        case UICommandType::UPDATE_TIMER_SETTING:
+            printf("%8.3f  setting   %d s\n", t, cmd.timerSeconds);
+            break;
+        case UICommandType::UPDATE_TIMER_START:
+            printf("%8.3f  start     %.3f s\n", t, (double)cmd.timerStartUs / 1e6);
+            break;
+    }
+}
+
+static int run_demo()
+{
+    sim_clock_reset();
+    sim_loadcell_set_source(demo_pressure, nullptr);
+
+    SimApp app(true);
+    app.setUiObserver(demo_observer, nullptr);
+    app.runUntil(30000000ULL);
+
+    printf("buzzer activations: %u\n", (unsigned)sim_buzzer_on_count());
+    return 0;
+}
+
+/* ── sim ─────────────────────────────────────────────────── */
+
+static float trace_source(uint64_t timeUs, void *ctx)
+{
+    return static_cast<PressureTrace *>(ctx)->at(timeUs);
+}
+
+static float synth_source(uint64_t timeUs, void *ctx)
+{
+    return static_cast<SynthTrace *>(ctx)->at(timeUs);
+}
+
+static void sim_usage(const char *prog)
+{
+    fprintf(stderr,
+        "usage: %s sim [options]\n"
+        "  --trace FILE            replay a CSV/binary trace (default: synthetic)\n"
+        "  --cycles N              synthetic press cycles (1000)\n"
+        "  --seed N                synthetic RNG seed (1)\n"
+        "  --noise G               synthetic noise, 1 sigma grams (15)\n"
+        "  --rattle G              synthetic idle knock amplitude, grams (60)\n"
+        "  --save-trace FILE       write the synthetic trace as CSV and exit\n"
+        "  --rate SPS              HX711 conversion rate (10)\n"
+        "  --timer S               timer setting in seconds (firmware default)\n"
+        "  --median N              filter: median window, 0 = off\n"
+        "  --iir A                 filter: IIR weight 0..1, 0 = off\n"
+        "  --iir-bypass G          filter: drop that skips the IIR, grams, 0 = never\n"
+        "  --kalman Q,R            filter: enable Kalman stage (cg² variances)\n"
+        "  --events                print every state transition\n"
+        "  --telemetry FILE        write the binary telemetry stream (tools/telemetry_decode.py)\n"
+        "  --max-latency-ms X      fail if p99 detection latency exceeds X\n"
+        "  --max-alert-error-ms X  fail if worst |alert error| exceeds X\n"
+        "  --max-alert-late-ms X   fail if an alert fires more than X after its deadline\n"
+        "  --max-false-starts N    fail if false starts exceed N\n"
+        "  --max-spurious-alerts N fail if alerts after the release exceed N\n",
+        prog);
+}
+
+static int run_sim(int argc, char **argv)
+{
+    const char     *tracePath = nullptr;
+    const char     *savePath  = nullptr;
+    const char     *telemetryPath = nullptr;
+    SynthConfig     synthCfg;
+    PressSimOptions opts;
+    FilterConfig    filterCfg      = filter_default_config();
+    uint32_t        rate           = 10;
+    double          maxLatencyMs   = -1.0;
+    double          maxAlertErrMs  = -1.0;
+    double          maxAlertLateMs = -1.0;
+    long            maxFalseStarts = -1;
+    long            maxSpurious    = -1;
+
+    for (int i = 2; i < argc; i++) {
+        const char *arg  = argv[i];
+        const char *next = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool        used = true;
+
+        if (strcmp(arg, "--events") == 0) { opts.printEvents = true; used = false; }
+        else if (!next)                              { sim_usage(argv[0]); return 2; }
+        else if (strcmp(arg, "--trace") == 0)        tracePath = next;
+        else if (strcmp(arg, "--save-trace") == 0)   savePath = next;
+        else if (strcmp(arg, "--cycles") == 0)       synthCfg.cycles = (uint32_t)atol(next);
+        else if (strcmp(arg, "--seed") == 0)         synthCfg.seed = (uint32_t)atol(next);
+        else if (strcmp(arg, "--noise") == 0)        synthCfg.noiseG = (float)atof(next);
+        else if (strcmp(arg, "--rattle") == 0)       synthCfg.rattleG = (float)atof(next);
+        else if (strcmp(arg, "--rate") == 0)         rate = (uint32_t)atol(next);
+        else if (strcmp(arg, "--timer") == 0)        opts.timerSeconds = atoi(next);
+        else if (strcmp(arg, "--telemetry") == 0)    telemetryPath = next;
+        else if (strcmp(arg, "--median") == 0)       filterCfg.medianWindow = (uint8_t)atoi(next);
+        else if (strcmp(arg, "--iir") == 0)
+            filterCfg.iirAlphaQ15 = (uint16_t)(atof(next) * 32768.0 + 0.5);
+        else if (strcmp(arg, "--iir-bypass") == 0)
+            filterCfg.iirBypassCg = (pressure_cg_t)(atof(next) * PRESSURE_CG_PER_GRAM);
+        else if (strcmp(arg, "--kalman") == 0) {
+            filterCfg.kalmanEnabled = sscanf(next, "%f,%f", &filterCfg.kalmanQ, &filterCfg.kalmanR) == 2;
+            if (!filterCfg.kalmanEnabled) { sim_usage(argv[0]); return 2; }
+        }
+        else if (strcmp(arg, "--max-latency-ms") == 0)     maxLatencyMs = atof(next);
+        else if (strcmp(arg, "--max-alert-error-ms") == 0) maxAlertErrMs = atof(next);
+        else if (strcmp(arg, "--max-alert-late-ms") == 0)  maxAlertLateMs = atof(next);
+        else if (strcmp(arg, "--max-false-starts") == 0)   maxFalseStarts = atol(next);
+        else if (strcmp(arg, "--max-spurious-alerts") == 0) maxSpurious = atol(next);
+        else { sim_usage(argv[0]); return 2; }
+
+        if (used) i++;
+    }
+
+    if (rate == 0) { sim_usage(argv[0]); return 2; }
+    if (telemetryPath) {
+        opts.telemetry = fopen(telemetryPath, "wb");
+        if (!opts.telemetry) {
+            fprintf(stderr, "cannot write %s\n", telemetryPath);
+            return 1;
+        }
+    }
+    sim_loadcell_set_rate(rate);
+    loadcell_set_filter(filterCfg);
+
+    PressSimReport report;
+    if (tracePath) {
+        PressureTrace trace;
+        if (!trace.load(tracePath)) {
+            fprintf(stderr, "cannot load trace %s\n", tracePath);
+            return 1;
+        }
+        report = press_sim_run(trace_source, &trace, trace.truePresses(PRESSURE_THRESHOLD),
+                               trace.durationUs(), opts);
+    } else {
+        SynthTrace synth(synthCfg);
+        if (savePath) {
+            PressureTrace out;
+            const std::vector<TruePress> &truth = synth.truePresses();
+            size_t p = 0;
+            for (uint64_t t = 0; t < synth.durationUs(); t += 1000000ULL / rate) {
+                while (p < truth.size() && truth[p].offUs <= t) p++;
+                int8_t pressed = (p < truth.size() && t >= truth[p].onUs) ? 1 : 0;
+                out.add({ t, synth.at(t), pressed });
+            }
+            return out.saveCsv(savePath) ? 0 : 1;
+        }
+        report = press_sim_run(synth_source, &synth, synth.truePresses(),
+                               synth.durationUs(), opts);
+    }
+
+    press_sim_print(report);
+    if (opts.telemetry) fclose(opts.telemetry);
+
+    /* Regression gates */
+    int rc = 0;
+    double worstAlert = std::max(report.alertErrorMs.max(), -report.alertErrorMs.percentile(0));
+    if (maxLatencyMs >= 0.0 && report.detectLatencyMs.percentile(99) > maxLatencyMs) {
+        printf("FAIL: p99 detection latency %.1f ms > %.1f ms\n",
+               report.detectLatencyMs.percentile(99), maxLatencyMs);
+        rc = 1;
+    }
+    if (maxAlertErrMs >= 0.0 && worstAlert > maxAlertErrMs) {
+        printf("FAIL: worst alert timing error %.1f ms > %.1f ms\n", worstAlert, maxAlertErrMs);
+        rc = 1;
+    }
+    if (maxAlertLateMs >= 0.0 && report.alertLatenessMs.max() > maxAlertLateMs) {
+        printf("FAIL: alert %.3f ms after its deadline > %.3f ms\n",
+               report.alertLatenessMs.max(), maxAlertLateMs);
+        rc = 1;
+    }
+    if (maxFalseStarts >= 0 && (long)report.falseStarts > maxFalseStarts) {
+        printf("FAIL: %u false starts > %ld\n", report.falseStarts, maxFalseStarts);
+        rc = 1;
+    }
+    if (maxSpurious >= 0 && (long)report.spuriousAlerts > maxSpurious) {
+        printf("FAIL: %u alerts after the release > %ld\n", report.spuriousAlerts, maxSpurious);
+        rc = 1;
+    }
+    return rc;
+}
+
+/* ── bench ───────────────────────────────────────────────── */
+
+static int run_bench(int argc, char **argv)
+{
+    BenchFormat format = BenchFormat::TEXT;
+    const char *filter = nullptr;
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) format = BenchFormat::JSON;
+        else                                filter = argv[i];
+    }
+    return bench_run_all(filter, format) > 0 ? 0 : 1;
+}
+
+/* ── main ────────────────────────────────────────────────── */
+
+/* The unit tests in test/ link src/ and bring their own main() */
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char **argv)
+{
+    const char *mode = argc > 1 ? argv[1] : "demo";
+
+    if (strcmp(mode, "demo") == 0) {
+        return run_demo();
+    }
+    if (strcmp(mode, "sim") == 0) {
+        return run_sim(argc, argv);
+    }
+    if (strcmp(mode, "bench") == 0) {
+        return run_bench(argc, argv);
+    }
+
+    fprintf(stderr, "usage: %s [demo | sim [options] | bench [--json] [filter]]\n", argv[0]);
+    return 2;
+}
+#endif /* PIO_UNIT_TESTING */
@@ -0,0 +1,212 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+/* ── PressureTrace ───────────────────────────────────────── */
+
+static const char     BINARY_MAGIC[4] = { 'H', 'P', 'T', 'R' };
+static const uint32_t BINARY_VERSION  = 1;
+
+bool PressureTrace::load(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+
+    char magic[4] = {};
+    size_t n = fread(magic, 1, sizeof(magic), f);
+    rewind(f);
+
+    samples_.clear();
+    cursor_ = 0;
+    bool ok = (n == sizeof(magic) && memcmp(magic, BINARY_MAGIC, 4) == 0)
+              ? loadBinary(f) : loadCsv(f);
+    fclose(f);
+    return ok && !samples_.empty();
+}
+
+bool PressureTrace::loadCsv(FILE *f)
+{
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+
+        double timeMs;
+        float  grams;
+        int    pressed = -1;
+        int    fields  = sscanf(line, "%lf,%f,%d", &timeMs, &grams, &pressed);
+        if (fields < 2) continue;   /* header or blank line */
+
+        TraceSample s;
+        s.timeUs  = (uint64_t)llround(timeMs * 1000.0);
+        s.grams   = grams;
+        s.pressed = (fields == 3) ? (int8_t)(pressed != 0) : (int8_t)-1;
+        samples_.push_back(s);
+    }
+    return true;
+}
+
+bool PressureTrace::loadBinary(FILE *f)
+{
+    char     magic[4];
+    uint32_t version, count;
+    if (fread(magic, 1, 4, f) != 4 ||
+        fread(&version, sizeof(version), 1, f) != 1 ||
+        fread(&count, sizeof(count), 1, f) != 1 ||
+        version != BINARY_VERSION) {
+        return false;
+    }
+
+    samples_.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t timeMs;
+        float    grams;
+        if (fread(&timeMs, sizeof(timeMs), 1, f) != 1 ||
+            fread(&grams, sizeof(grams), 1, f) != 1) {
+            return false;
+        }
+        samples_.push_back({ (uint64_t)timeMs * 1000ULL, grams, -1 });
+    }
+    return true;
+}
+
+bool PressureTrace::saveCsv(const char *path) const
+{
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+
+    fprintf(f, "time_ms,grams,pressed\n");
+    for (const TraceSample &s : samples_) {
+        fprintf(f, "%.3f,%.2f,%d\n", (double)s.timeUs / 1000.0, s.grams, s.pressed);
+    }
+    fclose(f);
+    return true;
+}
+
+float PressureTrace::at(uint64_t timeUs) const
+{
+    if (samples_.empty() || timeUs < samples_[0].timeUs) return 0.0f;
+
+    if (cursor_ >= samples_.size() || samples_[cursor_].timeUs > timeUs) {
+        cursor_ = 0;   /* time went backwards: new run */
+    }
+    while (cursor_ + 1 < samples_.size() && samples_[cursor_ + 1].timeUs <= timeUs) {
+        cursor_++;
+    }
+    return samples_[cursor_].grams;
+}
+
+std::vector<TruePress> PressureTrace::truePresses(float thresholdGrams) const
+{
+    std::vector<TruePress> presses;
+    bool     inPress = false;
+    uint64_t onUs    = 0;
+
+    for (const TraceSample &s : samples_) {
+        bool pressed = (s.pressed >= 0) ? (s.pressed != 0) : (s.grams > thresholdGrams);
+        if (pressed && !inPress) {
+            onUs    = s.timeUs;
+            inPress = true;
+        } else if (!pressed && inPress) {
+            presses.push_back({ onUs, s.timeUs });
+            inPress = false;
+        }
+    }
+    if (inPress) presses.push_back({ onUs, durationUs() });
+    return presses;
+}
+
+/* ── SynthTrace ──────────────────────────────────────────── */
+
+static uint64_t splitmix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/* Uniform [0, 1) from a counter-based generator */
+static float uniform(uint64_t seed, uint64_t n)
+{
+    return (float)(splitmix64(seed ^ splitmix64(n)) >> 40) / (float)(1ULL << 24);
+}
+
+/* Approximately N(0, 1): Irwin–Hall sum of four uniforms */
+static float gaussian(uint64_t seed, uint64_t n)
+{
+    float sum = uniform(seed, 4 * n) + uniform(seed, 4 * n + 1) +
+                uniform(seed, 4 * n + 2) + uniform(seed, 4 * n + 3);
+    return (sum - 2.0f) * 1.7320508f;
+}
+
+static const uint64_t RATTLE_US = 300000;   /* one knock lasts 300 ms */
+
+SynthTrace::SynthTrace(const SynthConfig &cfg)
+    : cfg_(cfg)
+{
+    uint64_t n = 0;
+    auto rand = [&](float lo, float hi) { return lo + (hi - lo) * uniform(cfg_.seed, n++); };
+
+    uint64_t t = (uint64_t)(rand(cfg_.gapMinS, cfg_.gapMaxS) * 1e6f);
+    for (uint32_t i = 0; i < cfg_.cycles; i++) {
+        uint64_t pressUs = (uint64_t)(rand(cfg_.pressMinS, cfg_.pressMaxS) * 1e6f);
+        presses_.push_back({ t, t + pressUs });
+        loads_.push_back(rand(cfg_.loadMinG, cfg_.loadMaxG));
+
+        uint64_t gapUs = (uint64_t)(rand(cfg_.gapMinS, cfg_.gapMaxS) * 1e6f);
+        uint64_t gapStart = t + pressUs + (uint64_t)(cfg_.rampMs * 1000.0f);
+
+        /* Knocks while the plate is open (not part of any press) */
+        float knocks = cfg_.rattlePerMin * (float)gapUs / 60e6f;
+        for (uint32_t k = 0; k < (uint32_t)(knocks + rand(0.0f, 1.0f)); k++) {
+            uint64_t at = gapStart + (uint64_t)(rand(0.0f, 1.0f) * (float)gapUs);
+            if (at + RATTLE_US < t + pressUs + gapUs) rattles_.push_back(at);
+        }
+        t += pressUs + gapUs;
+    }
+    endUs_ = t;
+
+    std::sort(rattles_.begin(), rattles_.end());
+}
+
+float SynthTrace::at(uint64_t timeUs) const
+{
+    float grams = cfg_.noiseG * gaussian(cfg_.seed + 1, timeUs);
+
+    /* Current or next press (cursor advances with time; reset if t went back) */
+    float rampUs = cfg_.rampMs * 1000.0f;
+    if (cursor_ > 0 && (float)presses_[cursor_ - 1].offUs + rampUs > (float)timeUs) {
+        cursor_ = 0;
+    }
+    while (cursor_ < presses_.size() && (float)presses_[cursor_].offUs + rampUs <= (float)timeUs) {
+        cursor_++;
+    }
+    if (cursor_ < presses_.size()) {
+        const TruePress &p = presses_[cursor_];
+        if (timeUs >= p.onUs) {
+            float load = loads_[cursor_];
+            float up   = (float)(timeUs - p.onUs) / rampUs;
+            float down = (timeUs >= p.offUs) ? (float)(timeUs - p.offUs) / rampUs : 0.0f;
+            float k    = (up < 1.0f ? up : 1.0f) - (down < 1.0f ? down : 1.0f);
+            grams += load * (k > 0.0f ? k : 0.0f);
+        }
+    }
+
+    /* Triangular knocks */
+    if (rattleCursor_ > 0 && rattles_[rattleCursor_ - 1] + RATTLE_US > timeUs) {
+        rattleCursor_ = 0;
+    }
+    while (rattleCursor_ < rattles_.size() && rattles_[rattleCursor_] + RATTLE_US <= timeUs) {
+        rattleCursor_++;
+    }
+    if (rattleCursor_ < rattles_.size() && timeUs >= rattles_[rattleCursor_]) {
+        uint64_t start = rattles_[rattleCursor_];
+        float    phase = (float)(timeUs - start) / (float)RATTLE_US;          /* 0..1 */
+        float    peak  = cfg_.rattleG * (0.5f + uniform(cfg_.seed + 2, start));
+        grams += peak * (1.0f - fabsf(2.0f * phase - 1.0f));
+    }
+
+    return grams;
+}
@@ -0,0 +1,99 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Load-cell pressure traces for the simulator.
+ *
+ * CSV:    time_ms,grams[,pressed]   ('#' comments and a header line are skipped;
+ *                                    pressed = 0/1 ground truth, optional)
+ * Binary: "HPTR" magic, uint32 version (1), uint32 count,
+ *         then count × { uint32 time_ms; float grams }   (little-endian)
+ */
+
+struct TraceSample {
+    uint64_t timeUs;
+    float    grams;
+    int8_t   pressed;   /* ground truth: 1 / 0, or -1 when unknown */
+};
+
+/** A press the operator actually made: load on the plate in [onUs, offUs) */
+struct TruePress {
+    uint64_t onUs;
+    uint64_t offUs;
+};
+
+class PressureTrace {
+public:
+    /** Load a CSV or binary trace (format picked from the file's magic) */
+    bool load(const char *path);
+
+    /** Write as CSV (time_ms,grams,pressed) */
+    bool saveCsv(const char *path) const;
+
+    /** Pressure at time t (sample-and-hold of the latest sample ≤ t) */
+    float at(uint64_t timeUs) const;
+
+    /**
+     * Ground-truth press intervals: from the pressed column when the
+     * trace has one, otherwise where grams > thresholdGrams.
+     */
+    std::vector<TruePress> truePresses(float thresholdGrams) const;
+
+    uint64_t durationUs() const { return samples_.empty() ? 0 : samples_.back().timeUs; }
+    size_t   size() const { return samples_.size(); }
+
+    void add(const TraceSample &s) { samples_.push_back(s); }
+
+private:
+    bool loadCsv(FILE *f);
+    bool loadBinary(FILE *f);
+
+    std::vector<TraceSample> samples_;
+    mutable size_t cursor_ = 0;   /* at() is called with increasing t */
+};
+
+/**
+ * Synthetic press-cycle generator. Deterministic for a given seed:
+ * pressure is a pure function of time, so a run of thousands of cycles
+ * needs no storage.
+ */
+struct SynthConfig {
+    uint32_t cycles       = 1000;
+    uint32_t seed         = 1;
+    float    loadMinG     = 3000.0f;  /* plate load while pressed */
+    float    loadMaxG     = 40000.0f;
+    float    pressMinS    = 5.0f;     /* time the press stays closed */
+    float    pressMaxS    = 30.0f;
+    float    gapMinS      = 3.0f;     /* idle time between presses */
+    float    gapMaxS      = 15.0f;
+    float    rampMs       = 150.0f;   /* close/open ramp */
+    float    noiseG       = 15.0f;    /* gaussian-ish noise, 1 sigma */
+    float    rattleG      = 60.0f;    /* idle knocks around the threshold */
+    float    rattlePerMin = 2.0f;
+};
+
+class SynthTrace {
+public:
+    explicit SynthTrace(const SynthConfig &cfg);
+
+    float at(uint64_t timeUs) const;
+
+    const std::vector<TruePress> &truePresses() const { return presses_; }
+    uint64_t durationUs() const { return endUs_; }
+
+private:
+    SynthConfig            cfg_;
+    std::vector<TruePress> presses_;
+    std::vector<float>     loads_;
+    std::vector<uint64_t>  rattles_;   /* knock start times */
+    uint64_t               endUs_ = 0;
+    mutable size_t         cursor_ = 0;
+    mutable size_t         rattleCursor_ = 0;
+};
+
+#endif /* TRACE_H */
@@ -0,0 +1,301 @@
+#include "cycle_log.h"
+#include "../config.h"
+#include "../diag/console.h"
+#include "../util/crc16.h"
+#include "../util/spsc_ring.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CYCLELOG_DIR "/cyc"
+
+/* On-flash record (little-endian, 32 bytes) */
+struct CycleRecord {
+    uint32_t seq;           // Increases by one per record, never reused
+    uint16_t boot;          // Power-on count when the cycle was recorded
+    uint16_t timerSeconds;
+    uint32_t startMs;
+    uint32_t durationMs;
+    uint32_t overtimeMs;
+    int32_t  peak;          // centigrams
+    int32_t  mean;          // centigrams
+    uint8_t  flags;
+    uint8_t  reserved;
+    uint16_t crc;           // CRC-16/CCITT over the bytes above
+};
+static_assert(sizeof(CycleRecord) == 32, "CycleRecord must stay 32 bytes on flash");
+
+/* logic task → loop task */
+static SpscRing<PressCycle, CYCLELOG_QUEUE_SIZE> pending;
+
+static bool     mounted      = false;
+static uint32_t nextSeq      = 0;
+static uint16_t bootCount    = 0;
+static uint32_t headSegment  = 0;   /* segment being appended to */
+static uint32_t tailSegment  = 0;   /* oldest segment on flash */
+static uint32_t headRecords  = 0;   /* records already in the head segment */
+static uint32_t firstPendingMs = 0;
+
+/* ── Helpers ─────────────────────────────────────────────── */
+
+static void segment_path(uint32_t segment, char *buf, size_t len)
+{
+    snprintf(buf, len, CYCLELOG_DIR "/%08lu.log", (unsigned long)segment);
+}
+
+static uint16_t record_crc(const CycleRecord &r)
+{
+    return crc16_ccitt((const uint8_t *)&r, offsetof(CycleRecord, crc));
+}
+
+/* Boot counter: one tiny write per power-on */
+static void bump_boot_count()
+{
+    File f = LittleFS.open(CYCLELOG_DIR "/boot", "r");
+    if (f) {
+        f.read((uint8_t *)&bootCount, sizeof(bootCount));
+        f.close();
+    }
+    bootCount++;
+
+    f = LittleFS.open(CYCLELOG_DIR "/boot", "w");
+    if (f) {
+        f.write((const uint8_t *)&bootCount, sizeof(bootCount));
+        f.close();
+    }
+}
+
+/**
+ * Read back from the end of `segment` to its last record with a valid CRC.
+ * @param[out] seq   That record's sequence number
+ * @param[out] size  File size in bytes
+ * @return index of that record + 1, 0 if the segment holds none
+ */
+static uint32_t last_valid_record(uint32_t segment, uint32_t &seq, size_t &size)
+{
+    char path[32];
+    segment_path(segment, path, sizeof(path));
+    File f = LittleFS.open(path, "r");
+    size = 0;
+    if (!f) return 0;
+
+    size = f.size();
+    uint32_t records = size / sizeof(CycleRecord);
+    while (records > 0) {
+        CycleRecord r;
+        f.seek((records - 1) * sizeof(CycleRecord));
+        if (f.read((uint8_t *)&r, sizeof(r)) == sizeof(r) && r.crc == record_crc(r)) {
+            seq = r.seq;
+            break;
+        }
+        records--;   /* torn write at power loss */
+    }
+    f.close();
+    return records;
+}
+
+/* Bounded recovery: one directory pass, then reading back from the end of
+ * the newest segment; older segments only while no valid record is found */
+static void recover()
+{
+    bool     any    = false;
+    uint32_t newest = 0, oldest = 0;
+
+    nextSeq     = 0;
+    tailSegment = headSegment = headRecords = 0;
+
+    File dir = LittleFS.open(CYCLELOG_DIR);
+    for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+        const char *name = strrchr(f.name(), '/');
+        name = name ? name + 1 : f.name();
+
+        char *end;
+        uint32_t segment = strtoul(name, &end, 10);
+        if (end == name || strcmp(end, ".log") != 0) continue;
+
+        if (!any || segment > newest) newest = segment;
+        if (!any || segment < oldest) oldest = segment;
+        any = true;
+    }
+
+    if (!any) return;
+
+    tailSegment = oldest;
+    headSegment = newest;
+
+    /* The newest valid record carries the sequence number to continue from */
+    uint32_t seq = 0;
+    size_t   size;
+    headRecords = last_valid_record(newest, seq, size);
+    bool found  = headRecords > 0;
+
+    /* A torn tail can't be appended to safely: start a fresh segment */
+    if (headRecords * sizeof(CycleRecord) != size) {
+        headSegment++;
+        headRecords = 0;
+    }
+
+    /* The head segment is empty or fully torn when power went right after
+     * it was opened: continue from the segments before it, or the next
+     * records would reuse their numbers */
+    for (uint32_t segment = newest; !found && segment > oldest; ) {
+        size_t olderSize;
+        found = last_valid_record(--segment, seq, olderSize) > 0;
+    }
+    if (found) nextSeq = seq + 1;
+}
+
+/* ── Writing ─────────────────────────────────────────────── */
+
+static void write_pending()
+{
+    if (pending.empty()) return;
+
+    PressCycle cycles[CYCLELOG_BATCH];
+    size_t n;
+    while ((n = pending.popBatch(cycles, CYCLELOG_BATCH)) > 0) {
+        size_t i = 0;
+        while (i < n) {
+            if (headRecords >= CYCLELOG_SEGMENT_RECORDS) {
+                headSegment++;
+                headRecords = 0;
+            }
+
+            char path[32];
+            segment_path(headSegment, path, sizeof(path));
+            File f = LittleFS.open(path, "a");
+            if (!f) return;
+
+            /* Everything that fits in this segment goes out in one write */
+            CycleRecord recs[CYCLELOG_BATCH];
+            size_t count = 0;
+            while (i < n && headRecords + count < CYCLELOG_SEGMENT_RECORDS) {
+                const PressCycle &c = cycles[i++];
+                CycleRecord &r = recs[count++];
+                r.seq          = nextSeq++;
+                r.boot         = bootCount;
+                r.timerSeconds = c.timerSeconds;
+                r.startMs      = c.startMs;
+                r.durationMs   = c.durationMs;
+                r.overtimeMs   = c.overtimeMs;
+                r.peak         = c.peak;
+                r.mean         = c.mean;
+                r.flags        = c.flags;
+                r.reserved     = 0;
+                r.crc          = record_crc(r);
+            }
+            f.write((const uint8_t *)recs, count * sizeof(CycleRecord));
+            f.close();
+            headRecords += count;
+        }
+    }
+
+    /* Ring: drop the oldest segments beyond the budget */
+    while (headSegment - tailSegment + 1 > CYCLELOG_MAX_SEGMENTS) {
+        char path[32];
+        segment_path(tailSegment++, path, sizeof(path));
+        LittleFS.remove(path);
+    }
+}
+
+/* ── Console ─────────────────────────────────────────────── */
+
+static void export_csv()
+{
+    Serial.println("seq,boot,start_ms,duration_ms,overtime_ms,peak_kg,mean_kg,timer_s,flags");
+
+    for (uint32_t segment = tailSegment; segment <= headSegment; segment++) {
+        char path[32];
+        segment_path(segment, path, sizeof(path));
+        if (!LittleFS.exists(path)) continue;
+        File f = LittleFS.open(path, "r");
+        if (!f) continue;
+
+        CycleRecord r;
+        while (f.read((uint8_t *)&r, sizeof(r)) == sizeof(r)) {
+            if (r.crc != record_crc(r)) continue;
+            Serial.printf("%lu,%u,%lu,%lu,%lu,%.2f,%.2f,%u,%s%s%s\n",
+                          (unsigned long)r.seq, r.boot, (unsigned long)r.startMs,
+                          (unsigned long)r.durationMs, (unsigned long)r.overtimeMs,
+                          pressure_to_centikg(r.peak) / 100.0f,
+                          pressure_to_centikg(r.mean) / 100.0f, r.timerSeconds,
+                          (r.flags & CYCLE_ALERTED) ? "A" : "",
+                          (r.flags & CYCLE_ACKNOWLEDGED) ? "K" : "",
+                          (r.flags & CYCLE_ABORTED) ? "X" : "");
+        }
+        f.close();
+    }
+}
+
+static void cmd_log(const char *args)
+{
+    if (!mounted) {
+        Serial.println("cycle log: filesystem not mounted");
+        return;
+    }
+
+    if (*args == '\0') {
+        cyclelog_flush();
+        export_csv();
+    } else if (strcmp(args, "stat") == 0) {
+        Serial.printf("cycle log: seq %lu, boot %u, segments %lu..%lu, %u queued, "
+                      "%u/%u kB used\n",
+                      (unsigned long)nextSeq, bootCount, (unsigned long)tailSegment,
+                      (unsigned long)headSegment, (unsigned)pending.size(),
+                      (unsigned)(LittleFS.usedBytes() / 1024),
+                      (unsigned)(LittleFS.totalBytes() / 1024));
+    } else if (strcmp(args, "clear") == 0) {
+        for (uint32_t segment = tailSegment; segment <= headSegment; segment++) {
+            char path[32];
+            segment_path(segment, path, sizeof(path));
+            LittleFS.remove(path);
+        }
+        /* Keep counting: sequence numbers are never reused */
+        tailSegment = headSegment = headSegment + 1;
+        headRecords = 0;
+    } else {
+        Serial.println("usage: log [stat | clear]");
+    }
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+bool cyclelog_init()
+{
+    console_register("log", "Export press cycles as CSV [stat | clear]", cmd_log);
+
+    /* Format on first use of the partition */
+    mounted = LittleFS.begin(true);
+    if (!mounted) return false;
+
+    LittleFS.mkdir(CYCLELOG_DIR);
+    bump_boot_count();
+    recover();
+    return true;
+}
+
+void cyclelog_append(const PressCycle &cycle, void *ctx)
+{
+    if (!mounted) return;
+
+    if (pending.empty()) firstPendingMs = millis();
+    pending.push(cycle);
+}
+
+void cyclelog_poll()
+{
+    if (!mounted || pending.empty()) return;
+
+    if (pending.size() >= CYCLELOG_BATCH ||
+        millis() - firstPendingMs >= CYCLELOG_FLUSH_MS) {
+        write_pending();
+    }
+}
+
+void cyclelog_flush()
+{
+    if (mounted) write_pending();
+}
@@ -0,0 +1,48 @@
+#ifndef CYCLE_LOG_H
+#define CYCLE_LOG_H
+
+#include <stdint.h>
+#include "../logic/app_state.h"
+
+/**
+ * Persistent press-cycle log on the LittleFS ("spiffs") partition.
+ *
+ * Records are fixed 32-byte entries with a sequence number and CRC,
+ * appended to segment files of CYCLELOG_SEGMENT_RECORDS records each
+ * (/cyc/00000000.log, ...). When more than CYCLELOG_MAX_SEGMENTS exist
+ * the oldest segment is deleted, so the log is a ring over the partition;
+ * LittleFS spreads the block writes for wear levelling.
+ *
+ * cyclelog_append() only queues into RAM. cyclelog_poll() writes queued
+ * records in batches (CYCLELOG_BATCH or after CYCLELOG_FLUSH_MS), so the
+ * press's hot path never touches flash. The boot scan lists the segment
+ * directory and reads back to the last valid record of the newest segment
+ * (of an older one if the newest holds none): its cost is bounded by
+ * CYCLELOG_MAX_SEGMENTS, not by the log size.
+ */
+
+/**
+ * Mount the filesystem, recover the log position and register the "log"
+ * console command. Call once from setup().
+ * @return false if the filesystem is unavailable (appends are then dropped)
+ */
+bool cyclelog_init();
+
+/**
+ * Queue a finished cycle (logic task; never blocks, never touches flash).
+ * Matches PressTimer::CycleSink.
+ */
+void cyclelog_append(const PressCycle &cycle, void *ctx);
+
+/**
+ * Write queued records when a batch is due. Call periodically from a
+ * low-priority task (loop()).
+ */
+void cyclelog_poll();
+
+/**
+ * Write all queued records now.
+ */
+void cyclelog_flush();
+
+#endif /* CYCLE_LOG_H */
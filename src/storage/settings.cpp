@@ -0,0 +1,219 @@
+#include "settings.h"
+#include "../config.h"
+#include "../diag/console.h"
+#include "../sensors/loadcell.h"
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <stdlib.h>
+#include <string.h>
+
+static Preferences prefs;
+
+static Settings     current;           /* RAM copy, what the firmware uses */
+static Settings     stored;            /* what NVS holds */
+static bool         dirty         = false;
+static uint32_t     lastChangeMs  = 0;
+static portMUX_TYPE settingsMux   = portMUX_INITIALIZER_UNLOCKED;
+
+/* ── Helpers ─────────────────────────────────────────────── */
+
+static void mark_dirty()
+{
+    dirty        = true;
+    lastChangeMs = millis();
+}
+
+static void commit()
+{
+    portENTER_CRITICAL(&settingsMux);
+    Settings s = current;
+    dirty      = false;
+    portEXIT_CRITICAL(&settingsMux);
+
+    /* Flash writes happen here, outside the critical section */
+    if (s.timerSeconds != stored.timerSeconds) prefs.putInt("timer", s.timerSeconds);
+    if (s.calFactor != stored.calFactor)       prefs.putFloat("cal", s.calFactor);
+    if (s.tareOffset != stored.tareOffset)     prefs.putInt("tare", s.tareOffset);
+    if (s.tareValid != stored.tareValid)       prefs.putBool("tareOk", s.tareValid);
+    if (memcmp(&s.touchCal, &stored.touchCal, sizeof(TouchCal)) != 0) {
+        prefs.putBytes("touchCal", &s.touchCal, sizeof(TouchCal));
+    }
+    if (s.touchCalValid != stored.touchCalValid) prefs.putBool("touchOk", s.touchCalValid);
+    if (memcmp(&s.filter, &stored.filter, sizeof(FilterConfig)) != 0) {
+        prefs.putBytes("filter", &s.filter, sizeof(FilterConfig));
+    }
+    stored = s;
+}
+
+/* ── Console ─────────────────────────────────────────────── */
+
+/* "median <n>" | "iir <α>" | "bypass <g>" | "kalman <q>,<r>" | "kalman off" | "default" */
+static bool parse_filter(const char *args, FilterConfig &cfg)
+{
+    if (strncmp(args, "median ", 7) == 0) {
+        cfg.medianWindow = (uint8_t)atoi(args + 7);
+    } else if (strncmp(args, "iir ", 4) == 0) {
+        cfg.iirAlphaQ15 = (uint16_t)(strtof(args + 4, nullptr) * 32768.0f + 0.5f);
+    } else if (strncmp(args, "bypass ", 7) == 0) {
+        cfg.iirBypassCg = (pressure_cg_t)(strtof(args + 7, nullptr) * PRESSURE_CG_PER_GRAM);
+    } else if (strcmp(args, "kalman off") == 0) {
+        cfg.kalmanEnabled = false;
+    } else if (strncmp(args, "kalman ", 7) == 0) {
+        float q, r;
+        if (sscanf(args + 7, "%f,%f", &q, &r) != 2) return false;
+        cfg.kalmanEnabled = true;
+        cfg.kalmanQ       = q;
+        cfg.kalmanR       = r;
+    } else if (strcmp(args, "default") == 0) {
+        cfg = filter_default_config();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static void cmd_set(const char *args)
+{
+    if (strncmp(args, "cal ", 4) == 0) {
+        float cal = strtof(args + 4, nullptr);
+        if (cal != 0.0f) {
+            settings_set_cal_factor(cal);
+            Serial.println("calibration factor applies after reboot");
+        }
+    } else if (strncmp(args, "timer ", 6) == 0) {
+        settings_set_timer(atoi(args + 6));
+        Serial.println("timer setting applies after reboot");
+    } else if (strncmp(args, "filter ", 7) == 0) {
+        /* Unlike the others this one applies now, for tuning on the bench */
+        FilterConfig f = loadcell_get_filter();
+        if (!parse_filter(args + 7, f)) {
+            Serial.println("usage: set filter [median <n> | iir <0..1> | bypass <g> | "
+                           "kalman <q>,<r> | kalman off | default]");
+            return;
+        }
+        loadcell_set_filter(f);
+        settings_set_filter(loadcell_get_filter());
+    } else if (*args != '\0') {
+        Serial.println("usage: set [cal <counts/g> | timer <s> | filter ...]");
+        return;
+    }
+
+    Settings s;
+    settings_get(s);
+    Serial.printf("timer=%lds cal=%.3f tare=%ld%s%s\n", (long)s.timerSeconds, s.calFactor,
+                  (long)s.tareOffset, s.tareValid ? "" : " (not measured)",
+                  dirty ? " (uncommitted)" : "");
+    Serial.printf("filter: median=%u iir=%.3f bypass=%.0fg kalman=%s q=%g r=%g\n",
+                  (unsigned)s.filter.medianWindow, s.filter.iirAlphaQ15 / 32768.0,
+                  (double)s.filter.iirBypassCg / PRESSURE_CG_PER_GRAM,
+                  s.filter.kalmanEnabled ? "on" : "off",
+                  (double)s.filter.kalmanQ, (double)s.filter.kalmanR);
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+void settings_init()
+{
+    prefs.begin("heatpress", false);
+
+    current.timerSeconds = prefs.getInt("timer", TIMER_DEFAULT_SECONDS);
+    current.calFactor    = prefs.getFloat("cal", LOADCELL_CAL_FACTOR);
+    current.tareOffset   = prefs.getInt("tare", 0);
+    current.tareValid    = prefs.getBool("tareOk", false);
+    current.touchCalValid = prefs.getBool("touchOk", false) &&
+        prefs.getBytes("touchCal", &current.touchCal, sizeof(TouchCal)) == sizeof(TouchCal);
+    if (!current.touchCalValid) current.touchCal = touch_cal_default();
+    if (prefs.getBytes("filter", &current.filter, sizeof(FilterConfig)) != sizeof(FilterConfig)) {
+        current.filter = filter_default_config();
+    }
+
+    if (current.timerSeconds < TIMER_MIN_SECONDS || current.timerSeconds > TIMER_MAX_SECONDS) {
+        current.timerSeconds = TIMER_DEFAULT_SECONDS;
+    }
+    stored = current;
+
+    console_register("set", "Show settings [cal <counts/g> | timer <s> | filter ...]", cmd_set);
+}
+
+void settings_get(Settings &out)
+{
+    portENTER_CRITICAL(&settingsMux);
+    out = current;
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void settings_set_timer(int32_t seconds)
+{
+    portENTER_CRITICAL(&settingsMux);
+    if (seconds != current.timerSeconds) {
+        current.timerSeconds = seconds;
+        mark_dirty();
+    }
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void settings_set_cal_factor(float countsPerGram)
+{
+    portENTER_CRITICAL(&settingsMux);
+    if (countsPerGram != current.calFactor) {
+        current.calFactor = countsPerGram;
+        mark_dirty();
+    }
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void settings_set_tare_offset(int32_t counts)
+{
+    portENTER_CRITICAL(&settingsMux);
+    if (counts != current.tareOffset || !current.tareValid) {
+        current.tareOffset = counts;
+        current.tareValid  = true;
+        mark_dirty();
+    }
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void settings_set_touch_cal(const TouchCal &cal)
+{
+    portENTER_CRITICAL(&settingsMux);
+    if (memcmp(&cal, &current.touchCal, sizeof(TouchCal)) != 0 || !current.touchCalValid) {
+        current.touchCal      = cal;
+        current.touchCalValid = true;
+        mark_dirty();
+    }
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void settings_set_filter(const FilterConfig &cfg)
+{
+    portENTER_CRITICAL(&settingsMux);
+    if (memcmp(&cfg, &current.filter, sizeof(FilterConfig)) != 0) {
+        current.filter = cfg;
+        mark_dirty();
+    }
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void settings_clear_touch_cal()
+{
+    portENTER_CRITICAL(&settingsMux);
+    if (current.touchCalValid) {
+        current.touchCal      = touch_cal_default();
+        current.touchCalValid = false;
+        mark_dirty();
+    }
+    portEXIT_CRITICAL(&settingsMux);
+}
+
+void settings_poll()
+{
+    if (dirty && millis() - lastChangeMs >= SETTINGS_COMMIT_DELAY_MS) {
+        commit();
+    }
+}
+
+void settings_flush()
+{
+    if (dirty) commit();
+}
@@ -0,0 +1,57 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <stdint.h>
+#include "../display/touch_cal.h"
+#include "../sensors/filter.h"
+
+/**
+ * Persistent settings in NVS (Preferences namespace "heatpress").
+ *
+ * Setters only change the RAM copy; settings_poll() commits once no
+ * change has arrived for SETTINGS_COMMIT_DELAY_MS, so a burst of +/-
+ * presses costs one flash write. Only keys whose value differs from
+ * what is stored are written. All functions are safe from any task.
+ */
+
+struct Settings {
+    int32_t timerSeconds;   // Countdown duration
+    float   calFactor;      // HX711 counts per gram
+    int32_t tareOffset;     // HX711 counts at zero load
+    bool    tareValid;      // tareOffset has been measured at least once
+    TouchCal touchCal;      // Raw → screen touch mapping
+    bool    touchCalValid;  // touchCal came from the calibration screen
+    FilterConfig filter;    // Load-cell filter chain (FILTER_* defaults)
+};
+
+/**
+ * Load settings (defaults from config.h for missing keys) and register
+ * the "set" console command. Call once from setup() before the tasks
+ * that read settings start.
+ */
+void settings_init();
+
+/** Current settings (RAM copy, including uncommitted changes) */
+void settings_get(Settings &out);
+
+void settings_set_timer(int32_t seconds);
+void settings_set_cal_factor(float countsPerGram);
+void settings_set_tare_offset(int32_t counts);
+void settings_set_touch_cal(const TouchCal &cal);
+void settings_set_filter(const FilterConfig &cfg);
+
+/** Forget the touch calibration (touch_cal_default() from the next boot) */
+void settings_clear_touch_cal();
+
+/**
+ * Commit pending changes once they have settled. Call periodically from
+ * a low-priority task (loop()).
+ */
+void settings_poll();
+
+/**
+ * Commit pending changes now.
+ */
+void settings_flush();
+
+#endif /* SETTINGS_H */
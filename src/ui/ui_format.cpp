@@ -0,0 +1,39 @@
+#include "ui_format.h"
+
+#include <stdio.h>
+
+/* Write a fixed-point value with `decimals` fractional digits */
+static void format_fixed(int32_t value, int32_t scale, int decimals, char *buf, size_t len)
+{
+    const char *sign = "";
+    uint32_t mag = (uint32_t)value;
+    if (value < 0) {
+        sign = "-";
+        mag  = 0u - (uint32_t)value;
+    }
+    snprintf(buf, len, "%s%u.%0*u", sign,
+             (unsigned)(mag / (uint32_t)scale), decimals, (unsigned)(mag % (uint32_t)scale));
+}
+
+void ui_format_pressure(pressure_cg_t pressure, bool showBar, char *buf, size_t len)
+{
+    /* Rounding to display units first means values within half a unit of
+     * zero show as "0.0"/"0.00", never "-0.0". */
+    if (showBar) {
+        format_fixed(pressure_to_decimbar(pressure), 10, 1, buf, len);
+    } else {
+        format_fixed(pressure_to_centikg(pressure), 100, 2, buf, len);
+    }
+}
+
+void ui_format_timer(int seconds, bool overtime, char *buf, size_t len)
+{
+    const char *sign = overtime ? "+" : "";
+    int mins = seconds / 60;
+    int secs = seconds % 60;
+    if (mins > 0) {
+        snprintf(buf, len, "%s%d:%02d", sign, mins, secs);
+    } else {
+        snprintf(buf, len, "%s%d", sign, secs);
+    }
+}
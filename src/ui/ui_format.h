@@ -0,0 +1,24 @@
+#ifndef UI_FORMAT_H
+#define UI_FORMAT_H
+
+#include <stddef.h>
+#include "../logic/pressure.h"
+
+/**
+ * Text formatting for the main screen. Pure functions (no LVGL),
+ * so they also build and benchmark on the host.
+ */
+
+/**
+ * Format a pressure reading for the pressure card.
+ * @param showBar  true: "12.3" (mbar over the plate), false: "1.25" (kg)
+ */
+void ui_format_pressure(pressure_cg_t pressure, bool showBar, char *buf, size_t len);
+
+/**
+ * Format the timer countdown: "45", "2:05", or "+7", "+1:02" in overtime.
+ * @param seconds   Whole seconds remaining (or elapsed past zero if overtime)
+ */
+void ui_format_timer(int seconds, bool overtime, char *buf, size_t len);
+
+#endif /* UI_FORMAT_H */
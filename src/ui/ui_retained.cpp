@@ -0,0 +1,73 @@
+#include "ui_retained.h"
+#include "../util/seqlock.h"
+
+#include <string.h>
+
+static UiRetainedStats          stats = {};   /* UI task only */
+static SeqLock<UiRetainedStats> statsOut;     /* copy of stats for other tasks */
+
+static void count_applied()
+{
+    stats.applied++;
+    statsOut.write(stats);
+}
+
+static void count_skipped()
+{
+    stats.skipped++;
+    statsOut.write(stats);
+}
+
+bool RetainedLabel::set(lv_obj_t *label, const char *text)
+{
+    if (valid_ && strncmp(text_, text, sizeof(text_)) == 0) {
+        count_skipped();
+        return false;
+    }
+
+    strncpy(text_, text, sizeof(text_) - 1);
+    text_[sizeof(text_) - 1] = '\0';
+    /* Text longer than the cache can't be compared reliably */
+    valid_ = strlen(text) < sizeof(text_);
+
+    lv_label_set_text(label, text);
+    count_applied();
+    return true;
+}
+
+bool RetainedArc::set(lv_obj_t *arc, int32_t value)
+{
+    /* Same mapping LVGL uses to place the indicator end */
+    int32_t sweep = lv_arc_get_bg_angle_end(arc) - lv_arc_get_bg_angle_start(arc);
+    if (sweep < 0) sweep += 360;
+    int32_t angle = lv_map(value, lv_arc_get_min_value(arc), lv_arc_get_max_value(arc),
+                           0, sweep);
+
+    if (valid_ && angle == angle_) {
+        count_skipped();
+        return false;
+    }
+
+    angle_ = angle;
+    valid_ = true;
+
+    lv_arc_set_value(arc, (int16_t)value);
+    count_applied();
+    return true;
+}
+
+bool RetainedInt::changed(int32_t v)
+{
+    if (valid_ && v == value_) {
+        count_skipped();
+        return false;
+    }
+    value_ = v;
+    valid_ = true;
+    return true;
+}
+
+void ui_retained_get_stats(UiRetainedStats &out)
+{
+    if (!statsOut.read(out)) out = UiRetainedStats{};
+}
@@ -0,0 +1,76 @@
+#ifndef UI_RETAINED_H
+#define UI_RETAINED_H
+
+#include <lvgl.h>
+#include <stdint.h>
+
+/**
+ * Retained widget state.
+ *
+ * Every lv_label_set_text()/lv_arc_set_value() call invalidates the widget,
+ * which costs a redraw and an SPI flush of its area on the next frame even
+ * if the pixels end up identical. These wrappers remember what each widget
+ * currently shows and only call into LVGL when the visible output changes.
+ * UI task only, like the rest of LVGL.
+ */
+
+#define UI_RETAINED_TEXT_MAX 24
+
+/**
+ * Counters for all retained widgets (cumulative since boot).
+ */
+struct UiRetainedStats {
+    uint32_t applied;   // Updates passed on to LVGL
+    uint32_t skipped;   // Avoided invalidations (value already on screen)
+};
+
+/** Label whose text is only set when it differs from what is shown */
+class RetainedLabel {
+public:
+    /** @return true if the label was updated */
+    bool set(lv_obj_t *label, const char *text);
+
+    /** Forget the cached text (next set() always applies) */
+    void invalidate() { valid_ = false; }
+
+private:
+    char text_[UI_RETAINED_TEXT_MAX] = {};
+    bool valid_ = false;
+};
+
+/**
+ * Arc whose value is quantized to the resolution it is drawn at: updates
+ * that would not move the indicator by a whole degree are skipped.
+ */
+class RetainedArc {
+public:
+    /** @return true if the arc was updated */
+    bool set(lv_obj_t *arc, int32_t value);
+
+    void invalidate() { valid_ = false; }
+
+private:
+    int32_t angle_ = 0;
+    bool    valid_ = false;
+};
+
+/** Cheap change check for values that are expensive to format */
+class RetainedInt {
+public:
+    /** @return true (and remember v) if v differs from the last value */
+    bool changed(int32_t v);
+
+    void invalidate() { valid_ = false; }
+
+private:
+    int32_t value_ = 0;
+    bool    valid_ = false;
+};
+
+/**
+ * Copy the retained-state counters (safe from any task: published through
+ * a SeqLock, so the copy is never torn).
+ */
+void ui_retained_get_stats(UiRetainedStats &stats);
+
+#endif /* UI_RETAINED_H */
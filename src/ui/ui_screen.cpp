@@ -2,6 +2,7 @@
 #include "ui_theme.h"
 #include "../config.h"
 #include "../logic/app_state.h"
+#include "ui_touch_cal.h"
 
 /* ── Widget handles ─────────────────────────────────────── */
 static lv_obj_t *scr             = nullptr;
@@ -61,6 +62,22 @@ static void pressure_card_click_cb(lv_event_t *e)
     ui_toggle_pressure_unit();
 }
 
+static void pressure_card_hold_cb(lv_event_t *e)
+{
+    /* Holding the card for TOUCH_CAL_LONG_PRESS_MS opens touch calibration
+     * (still reachable when the current mapping misses the buttons) */
+    static uint32_t pressedAt = 0;
+    static bool     opened    = false;
+
+    if (lv_event_get_code(e) == LV_EVENT_PRESSED) {
+        pressedAt = lv_tick_get();
+        opened    = false;
+    } else if (!opened && lv_tick_elaps(pressedAt) >= TOUCH_CAL_LONG_PRESS_MS) {
+        opened = true;
+        ui_touch_cal_request();
+    }
+}
+
 /* ── Helper: create a material button ────────────────────── */
 
 static lv_obj_t* create_btn(lv_obj_t *parent, const char *text,
@@ -135,7 +152,10 @@ void ui_screen_create(QueueHandle_t actionQueue)
     lv_obj_align(pressure_card, LV_ALIGN_TOP_RIGHT, -10, 18);
     lv_obj_clear_flag(pressure_card, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_add_flag(pressure_card, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_add_event_cb(pressure_card, pressure_card_click_cb, LV_EVENT_CLICKED, nullptr);
+    /* SHORT_CLICKED: releasing a long press (calibration) must not toggle */
+    lv_obj_add_event_cb(pressure_card, pressure_card_click_cb, LV_EVENT_SHORT_CLICKED, nullptr);
+    lv_obj_add_event_cb(pressure_card, pressure_card_hold_cb, LV_EVENT_PRESSED, nullptr);
+    lv_obj_add_event_cb(pressure_card, pressure_card_hold_cb, LV_EVENT_PRESSING, nullptr);
 
     /* Pressure value */
     pressure_label = lv_label_create(pressure_card);
@@ -201,6 +221,7 @@ void ui_screen_create(QueueHandle_t actionQueue)
 
 /* ── Getters ─────────────────────────────────────────────── */
 
+lv_obj_t* ui_get_screen()              { return scr; }
 lv_obj_t* ui_get_pressure_label()      { return pressure_label; }
 lv_obj_t* ui_get_timer_label()         { return timer_label; }
 lv_obj_t* ui_get_timer_arc()           { return timer_arc; }
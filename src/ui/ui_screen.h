@@ -13,7 +13,9 @@ void ui_screen_create(QueueHandle_t actionQueue);
 
 /**
  * Get references to UI widgets for updates.
+ * ui_get_screen() is the main screen, also while another one is loaded.
  */
+lv_obj_t* ui_get_screen();
 lv_obj_t* ui_get_pressure_label();
 lv_obj_t* ui_get_timer_label();
 lv_obj_t* ui_get_timer_arc();
@@ -0,0 +1,166 @@
+#include "ui_touch_cal.h"
+#include "ui_screen.h"
+#include "ui_theme.h"
+#include "../config.h"
+#include "../display/lv_setup.h"
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <stdio.h>
+
+/* Spread over the screen and not collinear, so the fit is well conditioned */
+static const int16_t TARGETS[3][2] = {
+    { TOUCH_CAL_MARGIN,                TOUCH_CAL_MARGIN },
+    { SCREEN_WIDTH - TOUCH_CAL_MARGIN, SCREEN_HEIGHT / 2 },
+    { SCREEN_WIDTH / 2,                SCREEN_HEIGHT - TOUCH_CAL_MARGIN },
+};
+
+static const lv_coord_t CROSS_SIZE = 21;
+
+static TouchCalDone  s_done    = nullptr;
+static void         *s_doneCtx = nullptr;
+static volatile bool requested = false;
+
+/* ── Widget handles (only while the screen is shown) ─────── */
+static lv_obj_t *calScr      = nullptr;
+static lv_obj_t *cross       = nullptr;
+static lv_obj_t *instruction = nullptr;
+
+/* ── Capture state ───────────────────────────────────────── */
+static uint8_t  step        = 0;
+static uint16_t raw[3][2];
+static bool     waitRelease = false;   // finger still down from opening the screen
+static bool     holding     = false;
+static uint32_t holdStartMs = 0;
+static uint32_t sumX = 0, sumY = 0, sumN = 0;
+
+static void show_target(const char *hint)
+{
+    lv_obj_set_pos(cross, TARGETS[step][0] - CROSS_SIZE / 2,
+                          TARGETS[step][1] - CROSS_SIZE / 2);
+
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%s\nTouch the cross (%u/3)", hint, (unsigned)(step + 1));
+    lv_label_set_text(instruction, buf);
+}
+
+static lv_obj_t* create_bar(lv_obj_t *parent, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t *bar = lv_obj_create(parent);
+    lv_obj_remove_style_all(bar);
+    lv_obj_set_size(bar, w, h);
+    lv_obj_set_style_bg_color(bar, COLOR_PRIMARY, 0);
+    lv_obj_set_style_bg_opa(bar, LV_OPA_COVER, 0);
+    lv_obj_center(bar);
+    return bar;
+}
+
+static void open_screen()
+{
+    calScr = lv_obj_create(nullptr);
+    lv_obj_set_style_bg_color(calScr, COLOR_BG, 0);
+    lv_obj_set_style_bg_opa(calScr, LV_OPA_COVER, 0);
+    lv_obj_clear_flag(calScr, LV_OBJ_FLAG_SCROLLABLE);
+
+    cross = lv_obj_create(calScr);
+    lv_obj_remove_style_all(cross);
+    lv_obj_set_size(cross, CROSS_SIZE, CROSS_SIZE);
+    lv_obj_clear_flag(cross, LV_OBJ_FLAG_CLICKABLE);
+    create_bar(cross, CROSS_SIZE, 1);
+    create_bar(cross, 1, CROSS_SIZE);
+
+    instruction = lv_label_create(calScr);
+    lv_obj_add_style(instruction, &style_label_small, 0);
+    lv_obj_set_style_text_align(instruction, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_align(instruction, LV_ALIGN_CENTER, 0, 0);
+
+    step        = 0;
+    holding     = false;
+    waitRelease = true;
+    show_target("Touch calibration");
+
+    lv_scr_load(calScr);
+}
+
+static void close_screen()
+{
+    lv_scr_load(ui_get_screen());
+    lv_obj_del(calScr);
+    calScr = cross = instruction = nullptr;
+}
+
+/* A target was released: keep its averaged raw point, or finish */
+static void capture()
+{
+    raw[step][0] = (uint16_t)(sumX / sumN);
+    raw[step][1] = (uint16_t)(sumY / sumN);
+
+    if (++step < 3) {
+        show_target("Touch calibration");
+        return;
+    }
+
+    TouchCal cal;
+    if (!touch_cal_solve(raw, TARGETS, cal)) {
+        step = 0;
+        show_target("Missed a target, try again");
+        return;
+    }
+
+    close_screen();
+    if (s_done) s_done(cal, s_doneCtx);
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+void ui_touch_cal_init(TouchCalDone done, void *ctx)
+{
+    s_done    = done;
+    s_doneCtx = ctx;
+}
+
+void ui_touch_cal_request()
+{
+    requested = true;
+}
+
+void ui_touch_cal_poll()
+{
+    if (requested) {
+        requested = false;
+        if (!calScr) open_screen();
+    }
+    if (!calScr) return;
+
+    /* Raw and unmapped: the current calibration may be the broken one */
+    uint16_t x, y;
+    bool pressed = lv_setup_touch_raw(x, y);
+
+    if (waitRelease) {
+        waitRelease = pressed;
+        return;
+    }
+
+    if (pressed) {
+        if (!holding) {
+            holding     = true;
+            holdStartMs = millis();
+            sumX = sumY = sumN = 0;
+        }
+        sumX += x;
+        sumY += y;
+        sumN++;
+        return;
+    }
+
+    if (holding) {
+        holding = false;
+        /* Brushes and bounces are not a deliberate touch on the target */
+        if (millis() - holdStartMs >= TOUCH_CAL_HOLD_MS && sumN > 0) capture();
+    }
+}
+
+bool ui_touch_cal_active()
+{
+    return calScr != nullptr;
+}
@@ -0,0 +1,30 @@
+#ifndef UI_TOUCH_CAL_H
+#define UI_TOUCH_CAL_H
+
+#include "../display/touch_cal.h"
+
+/**
+ * Guided 3-point touch calibration screen.
+ *
+ * Shows a cross at three targets in turn and records the raw (unmapped)
+ * touch point at each, so a badly calibrated panel can still be fixed.
+ * The fitted mapping is handed to the done callback; the main screen
+ * (ui_screen_create) keeps running underneath and is loaded again after.
+ */
+
+/** Called on the UI task with a successfully fitted mapping */
+typedef void (*TouchCalDone)(const TouchCal &cal, void *ctx);
+
+/** Call once, after ui_screen_create() */
+void ui_touch_cal_init(TouchCalDone done, void *ctx);
+
+/** Open the calibration screen at the next poll (any task) */
+void ui_touch_cal_request();
+
+/** Call every UI frame (UI task) */
+void ui_touch_cal_poll();
+
+/** True while the calibration screen is shown */
+bool ui_touch_cal_active();
+
+#endif /* UI_TOUCH_CAL_H */
@@ -1,8 +1,11 @@
 #include "ui_update.h"
+#include "ui_format.h"
+#include "ui_retained.h"
 #include "ui_screen.h"
 #include "ui_theme.h"
 #include "../config.h"
 #include "../audio/buzzer.h"
+#include "../diag/profiler.h"
 
 #include <Arduino.h>
 #include <lvgl.h>
@@ -13,12 +16,13 @@ static AppState currentState = AppState::IDLE;
 
 /* Calibrating overlay (created lazily, shown/hidden on state change) */
 static lv_obj_t *calibratingOverlay = nullptr;
+static bool      booting            = false;   /* overlay stays up regardless of state */
 
 static void set_calibrating_overlay(bool show)
 {
-    if (show) {
+    if (show || booting) {
         if (!calibratingOverlay) {
-            calibratingOverlay = lv_obj_create(lv_scr_act());
+            calibratingOverlay = lv_obj_create(ui_get_screen());
             lv_obj_set_size(calibratingOverlay, SCREEN_WIDTH, SCREEN_HEIGHT);
             lv_obj_align(calibratingOverlay, LV_ALIGN_CENTER, 0, 0);
             lv_obj_set_style_bg_color(calibratingOverlay, COLOR_BG, 0);
@@ -51,8 +55,10 @@ static void set_calibrating_overlay(bool show)
 static bool alertBlinkOn = false;
 static unsigned long nextBlinkMs = 0;
 
-/* Arc animation state (local to UI task for smooth updates) */
-static unsigned long arcStartMs  = 0;
+/* Arc animation state (local to UI task for smooth updates). The start
+ * is the press onset from the logic task, on the same micros() clock, so
+ * the countdown doesn't lose the engage dwell and snapshot delivery */
+static uint32_t      arcStartUs    = 0;
 static unsigned long arcDurationMs = 0;
 static int cachedTimerDurationS = TIMER_DEFAULT_SECONDS;
 
@@ -61,27 +67,15 @@ static bool showBar = false;
 
 /* Mute state */
 static bool muted = false;
-static float lastPressureGrams = 0.0f;  /* cached for unit toggle */
+static pressure_cg_t lastPressure = 0;  /* cached for unit toggle */
 
-/* Format pressure value into buf based on current unit mode */
-static void format_pressure(float grams, char *buf, size_t len)
-{
-    if (showBar) {
-        float forceN = (grams / 1000.0f) * 9.80665f;
-        float areaM2 = (PRESS_AREA_WIDTH_MM * PRESS_AREA_HEIGHT_MM) * 1e-6f;
-        float mbar = forceN / (areaM2 * 1e5f) * 1000.0f;
-        /* Dead zone: values within half a display unit (0.05) show as 0.0 */
-        if (mbar > -0.05f && mbar < 0.05f) mbar = 0.0f;
-        snprintf(buf, len, "%.1f", mbar);
-    } else {
-        float kg = grams / 1000.0f;
-        snprintf(buf, len, "%.2f", kg);
-    }
-
-    if (strncmp(buf, "-0.00", 5) == 0) {
-        strcpy(buf, "0.00");
-    }
-}
+/* What each widget currently shows (see ui_retained.h) */
+static RetainedLabel pressureText;
+static RetainedLabel timerText;
+static RetainedLabel statusText;
+static RetainedLabel timerSettingText;
+static RetainedArc   timerArc;
+static RetainedInt   timerShownSec;   /* signed: negative = overtime */
 
 /* ── State color helpers ─────────────────────────────────── */
 
@@ -91,12 +85,12 @@ static void set_idle_colors()
     lv_obj_set_style_arc_color(ui_get_timer_arc(), COLOR_PRIMARY, LV_PART_INDICATOR);
 
     lv_obj_t *status = ui_get_status_label();
-    lv_label_set_text(status, "IDLE");
+    statusText.set(status, "IDLE");
     lv_obj_set_style_text_color(status, COLOR_DIMMED, 0);
     lv_obj_set_style_text_font(status, &lv_font_montserrat_14, 0);
 
     /* Reset screen background */
-    lv_obj_set_style_bg_color(lv_scr_act(), COLOR_BG, 0);
+    lv_obj_set_style_bg_color(ui_get_screen(), COLOR_BG, 0);
 }
 
 static void set_timing_colors()
@@ -105,20 +99,20 @@ static void set_timing_colors()
     lv_obj_set_style_arc_color(ui_get_timer_arc(), COLOR_SUCCESS, LV_PART_INDICATOR);
 
     lv_obj_t *status = ui_get_status_label();
-    lv_label_set_text(status, LV_SYMBOL_PLAY " TIMING");
+    statusText.set(status, LV_SYMBOL_PLAY " TIMING");
     lv_obj_set_style_text_color(status, COLOR_SUCCESS, 0);
 }
 
 static void set_alert_colors()
 {
     lv_obj_t *status = ui_get_status_label();
-    lv_label_set_text(status, LV_SYMBOL_WARNING " DONE!");
+    statusText.set(status, LV_SYMBOL_WARNING " DONE!");
     lv_obj_set_style_text_color(status, COLOR_ERROR, 0);
     lv_obj_set_style_text_font(status, &lv_font_montserrat_20, 0);
     lv_obj_set_style_arc_color(ui_get_timer_arc(), COLOR_ERROR, LV_PART_INDICATOR);
 
     /* Immediately set alert background */
-    lv_obj_set_style_bg_color(lv_scr_act(), COLOR_ALERT_BG, 0);
+    lv_obj_set_style_bg_color(ui_get_screen(), COLOR_ALERT_BG, 0);
     lv_obj_set_style_bg_color(ui_get_pressure_card(), COLOR_ERROR, 0);
 }
 
@@ -137,11 +131,11 @@ static void alert_blink_tick()
 
         if (alertBlinkOn) {
             lv_obj_set_style_bg_color(ui_get_pressure_card(), COLOR_ERROR, 0);
-            lv_obj_set_style_bg_color(lv_scr_act(), COLOR_ALERT_BG, 0);
+            lv_obj_set_style_bg_color(ui_get_screen(), COLOR_ALERT_BG, 0);
             if (!muted) buzzer_on();
         } else {
             lv_obj_set_style_bg_color(ui_get_pressure_card(), lv_color_hex(0x4A0000), 0);
-            lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x2A0000), 0);
+            lv_obj_set_style_bg_color(ui_get_screen(), lv_color_hex(0x2A0000), 0);
             if (!muted) buzzer_off();
         }
     }
@@ -151,38 +145,24 @@ static void alert_blink_tick()
 
 void ui_handle_command(const UICommand &cmd)
 {
+    PROF_SCOPE(UI_HANDLE_COMMAND);
+
     switch (cmd.type) {
         case UICommandType::UPDATE_PRESSURE: {
-            lastPressureGrams = cmd.pressure;
+            lastPressure = cmd.pressure;
             char buf[16];
-            format_pressure(cmd.pressure, buf, sizeof(buf));
-            lv_label_set_text(ui_get_pressure_label(), buf);
+            ui_format_pressure(cmd.pressure, showBar, buf, sizeof(buf));
+            pressureText.set(ui_get_pressure_label(), buf);
             break;
         }
 
         case UICommandType::UPDATE_TIMER: {
             int secs = cmd.timerSeconds;
             char buf[12];
-            if (secs < 0) {
-                /* Overtime: show as +Xs */
-                int over = -secs;
-                int mins = over / 60;
-                int remainder = over % 60;
-                if (mins > 0) {
-                    snprintf(buf, sizeof(buf), "+%d:%02d", mins, remainder);
-                } else {
-                    snprintf(buf, sizeof(buf), "+%d", over);
-                }
-            } else {
-                int mins = secs / 60;
-                int remainder = secs % 60;
-                if (mins > 0) {
-                    snprintf(buf, sizeof(buf), "%d:%02d", mins, remainder);
-                } else {
-                    snprintf(buf, sizeof(buf), "%d", secs);
-                }
-            }
-            lv_label_set_text(ui_get_timer_label(), buf);
+            /* Overtime: show as +Xs */
+            ui_format_timer(secs < 0 ? -secs : secs, secs < 0, buf, sizeof(buf));
+            timerText.set(ui_get_timer_label(), buf);
+            timerShownSec.invalidate();   /* label no longer shows the arc's second */
             break;
         }
 
@@ -196,20 +176,19 @@ void ui_handle_command(const UICommand &cmd)
                 case AppState::IDLE:
                     set_calibrating_overlay(false);
                     set_idle_colors();
-                    lv_arc_set_value(ui_get_timer_arc(), 0);
+                    timerArc.set(ui_get_timer_arc(), 0);
                     break;
                 case AppState::CALIBRATING: set_calibrating_overlay(true); break;
                 case AppState::TIMING:
                     set_timing_colors();
-                    arcStartMs    = millis();
                     arcDurationMs = (unsigned long)cachedTimerDurationS * 1000UL;
-                    lv_arc_set_value(ui_get_timer_arc(), 0);
+                    timerArc.set(ui_get_timer_arc(), 0);
                     break;
                 case AppState::ALERT:
                     alertBlinkOn = false;
                     nextBlinkMs = millis();
                     set_alert_colors();
-                    lv_arc_set_value(ui_get_timer_arc(), INT16_MAX);
+                    timerArc.set(ui_get_timer_arc(), INT16_MAX);
                     break;
             }
             break;
@@ -219,6 +198,11 @@ void ui_handle_command(const UICommand &cmd)
             ui_update_timer_setting(cmd.timerSeconds);
             break;
         }
+
+        case UICommandType::UPDATE_TIMER_START:
+            arcStartUs = cmd.timerStartUs;
+            timerShownSec.invalidate();
+            break;
     }
 }
 
@@ -233,7 +217,7 @@ void ui_update_timer_setting(int durationSeconds)
 
     char buf[24];
     snprintf(buf, sizeof(buf), "Timer: %ds", durationSeconds);
-    lv_label_set_text(ui_get_timer_setting_label(), buf);
+    timerSettingText.set(ui_get_timer_setting_label(), buf);
 }
 
 void ui_arc_tick()
@@ -243,7 +227,7 @@ void ui_arc_tick()
 
     if (currentState != AppState::TIMING && currentState != AppState::ALERT) return;
 
-    unsigned long elapsed = millis() - arcStartMs;
+    unsigned long elapsed = (uint32_t)((uint32_t)micros() - arcStartUs) / 1000UL;
 
     /* Update arc (only during TIMING) */
     if (currentState == AppState::TIMING) {
@@ -254,38 +238,36 @@ void ui_arc_tick()
             progress = (int)((elapsed * (unsigned long)INT16_MAX) / arcDurationMs);
         }
         if (progress > INT16_MAX) progress = INT16_MAX;
-        lv_arc_set_value(ui_get_timer_arc(), progress);
+        timerArc.set(ui_get_timer_arc(), progress);
     }
 
-    /* Update timer text (whole seconds) */
+    /* Update timer text (whole seconds). Only format and touch the label
+     * when the displayed second changes, i.e. once per ~30 frames. */
     if (currentState == AppState::TIMING || currentState == AppState::ALERT) {
         long remainingMs = (long)arcDurationMs - (long)elapsed;
-        char buf[16];
+        bool overtime    = remainingMs < 0;
+        int  secs        = (int)((overtime ? -remainingMs : remainingMs) / 1000);
 
-        if (remainingMs < 0) {
-            /* Overtime */
-            int overSec = (int)(-remainingMs / 1000);
-            int mins = overSec / 60;
-            int secs = overSec % 60;
-            if (mins > 0) {
-                snprintf(buf, sizeof(buf), "+%d:%02d", mins, secs);
-            } else {
-                snprintf(buf, sizeof(buf), "+%d", secs);
-            }
-        } else {
-            int totalSec = (int)(remainingMs / 1000);
-            int mins = totalSec / 60;
-            int secs = totalSec % 60;
-            if (mins > 0) {
-                snprintf(buf, sizeof(buf), "%d:%02d", mins, secs);
-            } else {
-                snprintf(buf, sizeof(buf), "%d", secs);
-            }
-        }
-        lv_label_set_text(ui_get_timer_label(), buf);
+        /* Key on the sign too: "+0" (just past zero) differs from "0" */
+        if (!timerShownSec.changed(overtime ? -secs - 1 : secs)) return;
+
+        char buf[16];
+        ui_format_timer(secs, overtime, buf, sizeof(buf));
+        timerText.set(ui_get_timer_label(), buf);
     }
 }
 
+bool ui_needs_full_rate()
+{
+    return currentState != AppState::IDLE || booting;   /* spinner */
+}
+
+void ui_set_booting(bool on)
+{
+    booting = on;
+    set_calibrating_overlay(currentState == AppState::CALIBRATING);
+}
+
 void ui_toggle_pressure_unit()
 {
     showBar = !showBar;
@@ -298,8 +280,8 @@ void ui_toggle_pressure_unit()
 
     /* Refresh displayed value with cached pressure */
     char buf[16];
-    format_pressure(lastPressureGrams, buf, sizeof(buf));
-    lv_label_set_text(ui_get_pressure_label(), buf);
+    ui_format_pressure(lastPressure, showBar, buf, sizeof(buf));
+    pressureText.set(ui_get_pressure_label(), buf);
 }
 
 void ui_toggle_mute()
@@ -21,6 +21,18 @@ void ui_update_timer_setting(int durationSeconds);
  */
 void ui_arc_tick();
 
+/**
+ * True while something on screen moves every frame (arc, blink, spinner),
+ * i.e. the UI task should run at the full UI_REFRESH_PERIOD_MS rate.
+ */
+bool ui_needs_full_rate();
+
+/**
+ * Keep the calibrating overlay over the main screen while the load cell
+ * starts up, whatever state the logic task reports meanwhile.
+ */
+void ui_set_booting(bool booting);
+
 /**
  * Toggle pressure display between kg and bar.
  * Called from the pressure card click handler.
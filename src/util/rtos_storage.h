@@ -0,0 +1,66 @@
+#ifndef RTOS_STORAGE_H
+#define RTOS_STORAGE_H
+
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include "../config.h"
+
+/**
+ * Memory for one FreeRTOS task or queue, following RTOS_STATIC_ALLOC.
+ *
+ * Static: the TCB, stack and queue storage are members, so declaring the
+ * object at file scope puts them in .bss. The linker then accounts for
+ * them, and the heap only holds what is really dynamic (draw buffers,
+ * LVGL's own pool, Wi-Fi/driver internals). Dynamic: the object is
+ * empty and create() is the usual heap-allocating call.
+ *
+ * Stack sizes are in bytes, as everywhere in ESP-IDF's FreeRTOS.
+ */
+
+template <uint32_t StackBytes>
+class TaskStorage {
+public:
+    /** Same as xTaskCreatePinnedToCore(), minus the stack size */
+    BaseType_t create(TaskFunction_t fn, const char *name, void *arg,
+                      UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+    {
+#if RTOS_STATIC_ALLOC
+        TaskHandle_t h = xTaskCreateStaticPinnedToCore(
+            fn, name, StackBytes, arg, priority, stack_, &tcb_, core);
+        if (handle) *handle = h;
+        return h ? pdPASS : pdFAIL;
+#else
+        return xTaskCreatePinnedToCore(fn, name, StackBytes, arg, priority, handle, core);
+#endif
+    }
+
+private:
+#if RTOS_STATIC_ALLOC
+    StaticTask_t tcb_;
+    StackType_t  stack_[StackBytes / sizeof(StackType_t)];
+#endif
+};
+
+template <typename T, UBaseType_t Length>
+class QueueStorage {
+public:
+    /** Same as xQueueCreate(Length, sizeof(T)) */
+    QueueHandle_t create()
+    {
+#if RTOS_STATIC_ALLOC
+        return xQueueCreateStatic(Length, sizeof(T), items_, &queue_);
+#else
+        return xQueueCreate(Length, sizeof(T));
+#endif
+    }
+
+private:
+#if RTOS_STATIC_ALLOC
+    StaticQueue_t queue_;
+    uint8_t       items_[Length * sizeof(T)];
+#endif
+};
+
+#endif /* RTOS_STORAGE_H */
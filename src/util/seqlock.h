@@ -0,0 +1,75 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * Single-writer sequence lock for publishing a small POD snapshot.
+ *
+ * The writer never blocks: it bumps the sequence to odd, stores the
+ * value, and bumps it back to even. Readers copy the value and retry if
+ * the sequence was odd or moved underneath them, so a read is always a
+ * consistent snapshot of one write. The payload is stored as relaxed
+ * atomic words, which keeps the concurrent copy free of data races.
+ *
+ * Reads are wait-free unless they collide with a write, which for a
+ * snapshot written a few times per sample period is rare and short.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock needs a POD payload");
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "SeqLock payload must be whole words");
+
+public:
+    /** Writer side (one task only) */
+    void write(const T &value)
+    {
+        uint32_t buf[WORDS];
+        memcpy(buf, &value, sizeof(T));
+
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++) {
+            words_[i].store(buf[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Reader side (any task).
+     * @return false if nothing has been written yet
+     */
+    bool read(T &out) const
+    {
+        uint32_t buf[WORDS];
+        uint32_t before, after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; i++) {
+                buf[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        if (before == 0) return false;
+        memcpy(&out, buf, sizeof(T));
+        return true;
+    }
+
+    /** Changes on every write; cheap check before a full read() */
+    uint32_t version() const { return seq_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t WORDS = sizeof(T) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint32_t> words_[WORDS] = {};
+};
+
+#endif /* SEQLOCK_H */
@@ -0,0 +1,103 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Lock-free single-producer / single-consumer ring buffer.
+ *
+ * One task calls push(), one (other) task calls pop()/popBatch(); neither
+ * ever blocks or takes a lock. Capacity must be a power of two. The head
+ * and tail indices live on separate cache lines so the producer and
+ * consumer cores don't invalidate each other on every access.
+ *
+ * When the ring is full push() fails and the sample is counted in
+ * dropped(); the consumer is expected to drain fast enough that this
+ * only happens when it is stalled.
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    static constexpr size_t CACHE_LINE = 64;
+
+    /** Producer side. @return false if the ring is full */
+    bool push(const T &item)
+    {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tailCache_ == Capacity) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head - tailCache_ == Capacity) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        slots_[head & MASK] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer side. @return false if the ring is empty */
+    bool pop(T &item)
+    {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == headCache_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail == headCache_) return false;
+        }
+        item = slots_[tail & MASK];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer side: move up to maxItems into out[] with a single index
+     * publish. @return number of items copied
+     */
+    size_t popBatch(T *out, size_t maxItems)
+    {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        headCache_    = head_.load(std::memory_order_acquire);
+
+        size_t n = headCache_ - tail;
+        if (n > maxItems) n = maxItems;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = slots_[(tail + i) & MASK];
+        }
+        tail_.store(tail + (uint32_t)n, std::memory_order_release);
+        return n;
+    }
+
+    /** Approximate fill level (exact when called from either side) */
+    size_t size() const
+    {
+        return head_.load(std::memory_order_acquire) -
+               tail_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    /** Number of push() calls rejected because the ring was full */
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t MASK = Capacity - 1;
+
+    /* Producer-owned line: head index + cached view of tail */
+    alignas(CACHE_LINE) std::atomic<uint32_t> head_{0};
+    uint32_t              tailCache_ = 0;
+    std::atomic<uint32_t> dropped_{0};
+
+    /* Consumer-owned line: tail index + cached view of head */
+    alignas(CACHE_LINE) std::atomic<uint32_t> tail_{0};
+    uint32_t              headCache_ = 0;
+
+    alignas(CACHE_LINE) T slots_[Capacity];
+};
+
+#endif /* SPSC_RING_H */
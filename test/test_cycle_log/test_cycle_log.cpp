@@ -0,0 +1,122 @@
+/**
+ * Cycle log boot recovery (storage/cycle_log.cpp) on the in-memory
+ * LittleFS: after a reboot the next record continues the sequence, also
+ * when power was lost with the head segment opened but not yet written.
+ *
+ * cyclelog_init() stands in for a reboot; the RAM state is rebuilt from
+ * the files alone. pio test -e native
+ */
+
+#include <unity.h>
+#include <LittleFS.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+#include "storage/cycle_log.h"
+
+/* On-flash layout (CycleRecord in cycle_log.cpp): 32-byte records, seq first */
+static constexpr size_t RECORD_BYTES = 32;
+
+void setUp() { LittleFS.format(); }
+void tearDown() {}
+
+static void log_cycles(int count)
+{
+    PressCycle cycle = {};
+    cycle.timerSeconds = TIMER_DEFAULT_SECONDS;
+    cycle.flags        = CYCLE_ALERTED;
+    for (int i = 0; i < count; i++) {
+        cyclelog_append(cycle, nullptr);
+    }
+    cyclelog_flush();
+}
+
+static void segment_path(uint32_t segment, char *buf, size_t len)
+{
+    snprintf(buf, len, "/cyc/%08lu.log", (unsigned long)segment);
+}
+
+static size_t segment_records(uint32_t segment)
+{
+    char path[32];
+    segment_path(segment, path, sizeof(path));
+    File f = LittleFS.open(path, "r");
+    return f ? f.size() / RECORD_BYTES : 0;
+}
+
+static uint32_t seq_at(uint32_t segment, size_t index)
+{
+    char path[32];
+    segment_path(segment, path, sizeof(path));
+    File f = LittleFS.open(path, "r");
+    TEST_ASSERT_TRUE_MESSAGE((bool)f, path);
+
+    uint32_t seq = UINT32_MAX;
+    f.seek(index * RECORD_BYTES);
+    TEST_ASSERT_EQUAL(sizeof(seq), f.read((uint8_t *)&seq, sizeof(seq)));
+    return seq;
+}
+
+/* Power lost after write_pending() opened the segment: `bytes` of it made it */
+static void write_head_segment(uint32_t segment, size_t bytes)
+{
+    char path[32];
+    segment_path(segment, path, sizeof(path));
+    File f = LittleFS.open(path, "w");
+    uint8_t junk[RECORD_BYTES];
+    memset(junk, 0xA5, sizeof(junk));
+    f.write(junk, bytes);
+    f.close();
+}
+
+static void test_seq_continues_after_reboot()
+{
+    TEST_ASSERT_TRUE(cyclelog_init());
+    log_cycles(3);
+
+    TEST_ASSERT_TRUE(cyclelog_init());
+    log_cycles(1);
+
+    TEST_ASSERT_EQUAL(4, segment_records(0));
+    TEST_ASSERT_EQUAL_UINT32(0, seq_at(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(3, seq_at(0, 3));
+}
+
+static void test_seq_continues_past_empty_head_segment()
+{
+    TEST_ASSERT_TRUE(cyclelog_init());
+    log_cycles(3);
+    write_head_segment(1, 0);
+
+    TEST_ASSERT_TRUE(cyclelog_init());
+    log_cycles(1);
+
+    /* The empty segment is appended to, numbered after segment 0 */
+    TEST_ASSERT_EQUAL(1, segment_records(1));
+    TEST_ASSERT_EQUAL_UINT32(3, seq_at(1, 0));
+}
+
+static void test_seq_continues_past_torn_head_segment()
+{
+    TEST_ASSERT_TRUE(cyclelog_init());
+    log_cycles(3);
+    write_head_segment(1, RECORD_BYTES - 12);
+
+    TEST_ASSERT_TRUE(cyclelog_init());
+    log_cycles(1);
+
+    /* The torn segment is left alone; the next one continues the sequence */
+    TEST_ASSERT_EQUAL(0, segment_records(1));
+    TEST_ASSERT_EQUAL(1, segment_records(2));
+    TEST_ASSERT_EQUAL_UINT32(3, seq_at(2, 0));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_seq_continues_after_reboot);
+    RUN_TEST(test_seq_continues_past_empty_head_segment);
+    RUN_TEST(test_seq_continues_past_torn_head_segment);
+    return UNITY_END();
+}
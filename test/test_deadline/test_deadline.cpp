@@ -0,0 +1,193 @@
+/**
+ * PressTimer alert deadline (logic/press_timer.h): the logic task arms a
+ * one-shot for nextDeadline() after every wakeup; the alert must fire no
+ * later than the one-shot's own dispatch delay, whatever the press onset
+ * phase against the sample grid and however +/- moves the deadline.
+ *
+ * Driven on the virtual clock, without SimApp, so nothing but
+ * PressTimer's deadline arithmetic is under test. pio test -e native
+ */
+
+#include <unity.h>
+
+#include "config.h"
+#include "logic/press_timer.h"
+#include "sim/sim_clock.h"
+
+void setUp() { sim_clock_reset(); }
+void tearDown() {}
+
+static constexpr uint64_t SAMPLE_US  = 100000;   /* 10 SPS */
+static constexpr pressure_cg_t LOAD  = 5000 * PRESSURE_CG_PER_GRAM;
+static constexpr uint64_t NEVER      = UINT64_MAX;
+
+/* Longer than the timer even after one + step */
+static constexpr uint64_t HOLD_US =
+    (TIMER_MIN_SECONDS + TIMER_STEP_SECONDS + 2) * 1000000ULL;
+
+struct Press {
+    uint64_t onUs;
+    uint64_t offUs;
+    uint64_t changeUs;   /* timer +/- while timing, NEVER = none */
+    bool     increment;
+};
+
+struct JitterResult {
+    uint32_t alerts;
+    uint32_t worstLateUs;   /* PressTimer::alertLatenessUs() */
+    uint32_t worstErrUs;    /* ALERT time − deadline armed for it, measured here */
+    uint32_t early;         /* ALERT before its deadline */
+};
+
+static uint32_t rng_state = 1;
+static uint32_t rng()
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+/**
+ * Emulates logicTask: wake on each sample or on the deadline one-shot,
+ * process, tick(), then re-arm from nextDeadline() as arm_deadline()
+ * does. The one-shot fires up to dispatchUs after the time it was armed
+ * for (esp_timer task latency).
+ */
+static JitterResult run_presses(const Press *presses, size_t count, uint32_t dispatchUs)
+{
+    QueueHandle_t      actions = xQueueCreate(QUEUE_SIZE, sizeof(UserAction));
+    AppSnapshotChannel snapshot;
+    PressTimer         timer(snapshot, actions);
+    timer.setTimerDuration(TIMER_MIN_SECONDS);
+
+    JitterResult r       = {};
+    uint64_t nextSample  = SAMPLE_US;
+    uint64_t wakeAt      = NEVER;   /* armed one-shot incl. dispatch delay */
+    uint32_t armedAtUs   = 0;
+    bool     armed       = false;
+    size_t   p           = 0;       /* press on the plate or next */
+    size_t   c           = 0;       /* next press whose +/- is pending */
+    uint64_t endUs       = presses[count - 1].offUs + 2 * SAMPLE_US;
+
+    while (sim_clock_us() < endUs) {
+        uint64_t change = c < count ? presses[c].changeUs : NEVER;
+        uint64_t next   = nextSample < wakeAt ? nextSample : wakeAt;
+        if (change < next) next = change;
+        sim_clock_set_us(next);
+        uint64_t now = next;
+
+        if (now == change) {
+            UserAction a = { presses[c].increment ? UserActionType::TIMER_INCREMENT
+                                                  : UserActionType::TIMER_DECREMENT };
+            timer.processAction(a);
+        }
+        while (c < count && presses[c].changeUs <= now) c++;
+        if (now == nextSample) {
+            while (p < count && now >= presses[p].offUs) p++;
+            bool loaded = p < count && now >= presses[p].onUs;
+            timer.processPressure(loaded ? LOAD : 0, (uint32_t)now);
+            nextSample += SAMPLE_US;
+        }
+        if (now == wakeAt) {
+            wakeAt = NEVER;
+            armed  = false;
+        }
+
+        AppState before = timer.getState();
+        timer.tick();
+        if (before == AppState::TIMING && timer.getState() == AppState::ALERT) {
+            int32_t err = (int32_t)((uint32_t)now - armedAtUs);
+            if (err < 0) r.early++;
+            else if ((uint32_t)err > r.worstErrUs) r.worstErrUs = (uint32_t)err;
+            if (timer.alertLatenessUs() > r.worstLateUs) r.worstLateUs = timer.alertLatenessUs();
+            r.alerts++;
+        }
+
+        /* arm_deadline() */
+        uint32_t atUs;
+        if (!timer.nextDeadline(atUs)) {
+            wakeAt = NEVER;
+            armed  = false;
+        } else if (!armed || atUs != armedAtUs) {
+            int32_t waitUs = (int32_t)(atUs - (uint32_t)now);
+            if (waitUs < 1) waitUs = 1;
+            uint32_t delay = dispatchUs ? rng() % (dispatchUs + 1) : 0;
+            wakeAt    = now + (uint64_t)waitUs + delay;
+            armedAtUs = atUs;
+            armed     = true;
+        }
+        timer.publish();
+    }
+
+    vQueueDelete(actions);
+    return r;
+}
+
+/* Presses longer than the timer, onset anywhere between two samples */
+static size_t make_presses(Press *out, size_t count, bool withChanges)
+{
+    uint64_t t = 2 * SAMPLE_US;
+    for (size_t i = 0; i < count; i++) {
+        out[i].onUs      = t + rng() % SAMPLE_US;
+        out[i].offUs     = out[i].onUs + HOLD_US + rng() % 2000000;
+        out[i].changeUs  = NEVER;
+        out[i].increment = false;
+        if (withChanges) {
+            /* One step while timing, alternately + and −: the deadline
+             * moves by TIMER_STEP_SECONDS and has to be re-armed */
+            out[i].changeUs  = out[i].onUs + 1000000 + rng() % 1000000;
+            out[i].increment = (i & 1) == 0;
+        }
+        t = out[i].offUs + 3 * SAMPLE_US + rng() % SAMPLE_US;
+    }
+    return count;
+}
+
+static void test_alert_on_deadline_exactly()
+{
+    static Press presses[200];
+    size_t n = make_presses(presses, 200, false);
+
+    JitterResult r = run_presses(presses, n, 0);
+    TEST_ASSERT_EQUAL(n, r.alerts);
+    TEST_ASSERT_EQUAL(0, r.early);
+    /* arm_deadline() never arms less than 1 µs out */
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, r.worstLateUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, r.worstErrUs);
+}
+
+static void test_jitter_bounded_by_dispatch_delay()
+{
+    static Press presses[200];
+    size_t n = make_presses(presses, 200, false);
+
+    const uint32_t DISPATCH_US = 2000;
+    JitterResult r = run_presses(presses, n, DISPATCH_US);
+    TEST_ASSERT_EQUAL(n, r.alerts);
+    TEST_ASSERT_EQUAL(0, r.early);
+    /* No sample-period (100 ms) or whole-second quantization on top */
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(DISPATCH_US + 1, r.worstLateUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(DISPATCH_US + 1, r.worstErrUs);
+}
+
+static void test_rearmed_when_duration_changes()
+{
+    static Press presses[100];
+    size_t n = make_presses(presses, 100, true);
+
+    const uint32_t DISPATCH_US = 500;
+    JitterResult r = run_presses(presses, n, DISPATCH_US);
+    /* Every press still alerts, at the moved deadline: never at the
+     * stale one (early after +, late after −) */
+    TEST_ASSERT_EQUAL(n, r.alerts);
+    TEST_ASSERT_EQUAL(0, r.early);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(DISPATCH_US + 1, r.worstLateUs);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_alert_on_deadline_exactly);
+    RUN_TEST(test_jitter_bounded_by_dispatch_delay);
+    RUN_TEST(test_rearmed_when_duration_changes);
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+/**
+ * The sample → pixel pipeline benches (sim/bench_pipeline.cpp) as a test
+ * target, built against the real LVGL and ui_* code with the simulated
+ * display, loadcell, buzzer and FreeRTOS. Every pipeline_* and display_*
+ * bench must run; the checks after them cover what the bench numbers
+ * depend on: frames reach the framebuffer, the adaptive refresh follows
+ * the state, the countdown counts from the press onset.
+ *
+ * Timings are printed, not asserted: host ns/op say nothing about the
+ * ESP32. pio test -e native -f test_pipeline
+ */
+
+#include <unity.h>
+#include <lvgl.h>
+
+#include "config.h"
+#include "display/lv_setup.h"
+#include "sim/bench.h"
+#include "sim/sim_clock.h"
+#include "ui/ui_format.h"
+#include "ui/ui_screen.h"
+#include "ui/ui_update.h"
+
+void setUp() {}
+void tearDown() {}
+
+/* LVGL can only be initialized once per process and the benches own that
+ * instance (bench_pipeline.cpp, ui_ready()); running one builds the screen */
+static void ui_built()
+{
+    static int run = bench_run_all("pipeline_ui_pressure_command");
+    TEST_ASSERT_EQUAL_MESSAGE(1, run, "pipeline_ui_pressure_command not registered");
+}
+
+static void send_state(AppState state)
+{
+    UICommand cmd = {};
+    cmd.type  = UICommandType::UPDATE_STATE;
+    cmd.state = state;
+    ui_handle_command(cmd);
+}
+
+/* ── Benches ─────────────────────────────────────────────── */
+
+static void test_pipeline_benches_run()
+{
+    TEST_ASSERT_GREATER_THAN(0, bench_run_all("pipeline_"));
+}
+
+static void test_display_layout_benches_run()
+{
+    TEST_ASSERT_GREATER_THAN(0, bench_run_all("display_"));
+}
+
+/* ── What the numbers rest on ────────────────────────────── */
+
+static void test_pressure_reaches_framebuffer()
+{
+    ui_built();
+
+    FrameStats before, after;
+    lv_setup_get_frame_stats(before);
+
+    UICommand cmd = {};
+    cmd.type     = UICommandType::UPDATE_PRESSURE;
+    cmd.pressure = 123456;
+    ui_handle_command(cmd);
+    lv_refr_now(nullptr);
+
+    lv_setup_get_frame_stats(after);
+    TEST_ASSERT_GREATER_THAN(before.frames, after.frames);
+    TEST_ASSERT_GREATER_THAN(before.flushedPx, after.flushedPx);
+
+    char expect[16];
+    ui_format_pressure(cmd.pressure, false, expect, sizeof(expect));
+    TEST_ASSERT_EQUAL_STRING(expect, lv_label_get_text(ui_get_pressure_label()));
+}
+
+static void test_full_rate_follows_state()
+{
+    ui_built();
+
+    send_state(AppState::TIMING);
+    TEST_ASSERT_TRUE(ui_needs_full_rate());
+    send_state(AppState::ALERT);
+    TEST_ASSERT_TRUE(ui_needs_full_rate());
+    send_state(AppState::IDLE);
+    TEST_ASSERT_FALSE(ui_needs_full_rate());
+}
+
+static void test_countdown_counts_from_onset()
+{
+    ui_built();
+
+    UICommand setting = {};
+    setting.type         = UICommandType::UPDATE_TIMER_SETTING;
+    setting.timerSeconds = 15;
+    ui_handle_command(setting);
+
+    /* TIMING shown 2.5 s after the (backdated) onset: 12 s left, not 15 */
+    sim_clock_advance_us(5000000);
+    UICommand start = {};
+    start.type         = UICommandType::UPDATE_TIMER_START;
+    start.timerStartUs = (uint32_t)sim_clock_us() - 2500000;
+    ui_handle_command(start);
+    send_state(AppState::TIMING);
+    ui_arc_tick();
+
+    char expect[16];
+    ui_format_timer(12, false, expect, sizeof(expect));
+    TEST_ASSERT_EQUAL_STRING(expect, lv_label_get_text(ui_get_timer_label()));
+
+    send_state(AppState::IDLE);
+    lv_refr_now(nullptr);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_pipeline_benches_run);
+    RUN_TEST(test_display_layout_benches_run);
+    RUN_TEST(test_pressure_reaches_framebuffer);
+    RUN_TEST(test_full_rate_follows_state);
+    RUN_TEST(test_countdown_counts_from_onset);
+    return UNITY_END();
+}
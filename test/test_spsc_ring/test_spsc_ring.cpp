@@ -0,0 +1,150 @@
+/**
+ * SpscRing (util/spsc_ring.h): wraparound, full/empty, popBatch and a
+ * two-thread producer/consumer stress run. Host only: pio test -e native
+ */
+
+#include <unity.h>
+#include <thread>
+
+#include "util/spsc_ring.h"
+
+void setUp() {}
+void tearDown() {}
+
+/* ── Single-threaded ─────────────────────────────────────── */
+
+static void test_empty_ring_pops_nothing()
+{
+    SpscRing<uint32_t, 4> ring;
+    uint32_t v   = 0;
+    uint32_t out[4];
+
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_FALSE(ring.pop(v));
+    TEST_ASSERT_EQUAL(0, ring.popBatch(out, 4));
+}
+
+static void test_full_ring_rejects_and_counts_drops()
+{
+    SpscRing<uint32_t, 4> ring;
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.push(i));
+    }
+    TEST_ASSERT_EQUAL(4, ring.size());
+    TEST_ASSERT_FALSE(ring.push(99));
+    TEST_ASSERT_FALSE(ring.push(100));
+    TEST_ASSERT_EQUAL(2, ring.dropped());
+
+    /* The rejected items didn't overwrite anything */
+    uint32_t v;
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.pop(v));
+        TEST_ASSERT_EQUAL(i, v);
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+
+    /* Room again after draining */
+    TEST_ASSERT_TRUE(ring.push(5));
+}
+
+static void test_wraparound_keeps_fifo_order()
+{
+    /* Many passes over the slots with the fill level varying, so head and
+     * tail wrap at every offset */
+    SpscRing<uint32_t, 8> ring;
+    uint32_t next = 0, expect = 0, attempts = 0, v;
+
+    for (int round = 0; round < 1000; round++) {
+        int burst = 1 + round % 8;
+        for (int i = 0; i < burst; i++, attempts++) {
+            if (ring.push(next)) next++;
+        }
+        int take = 1 + (round * 3) % 8;
+        for (int i = 0; i < take && ring.pop(v); i++) {
+            TEST_ASSERT_EQUAL(expect, v);
+            expect++;
+        }
+    }
+    while (ring.pop(v)) {
+        TEST_ASSERT_EQUAL(expect, v);
+        expect++;
+    }
+    TEST_ASSERT_EQUAL(next, expect);
+    TEST_ASSERT_EQUAL(attempts - next, ring.dropped());
+}
+
+static void test_pop_batch_limits_and_wraps()
+{
+    SpscRing<uint32_t, 8> ring;
+    uint32_t out[8];
+
+    /* Move the indices so the batch crosses the end of the slot array */
+    for (uint32_t i = 0; i < 6; i++) ring.push(i);
+    TEST_ASSERT_EQUAL(6, ring.popBatch(out, 8));
+
+    for (uint32_t i = 0; i < 7; i++) ring.push(100 + i);
+    TEST_ASSERT_EQUAL(3, ring.popBatch(out, 3));
+    TEST_ASSERT_EQUAL(100, out[0]);
+    TEST_ASSERT_EQUAL(102, out[2]);
+
+    TEST_ASSERT_EQUAL(4, ring.popBatch(out, 8));
+    TEST_ASSERT_EQUAL(103, out[0]);
+    TEST_ASSERT_EQUAL(106, out[3]);
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+/* ── Two threads ─────────────────────────────────────────── */
+
+struct Item {
+    uint32_t seq;
+    uint32_t check;   // derived from seq, catches a torn or stale slot
+};
+
+static void test_producer_consumer_stress()
+{
+    static SpscRing<Item, 32> ring;
+    const uint32_t COUNT = 2000000;
+
+    std::thread producer([] {
+        for (uint32_t i = 0; i < COUNT;) {
+            Item it = { i, ~i * 2654435761u };
+            if (ring.push(it)) i++;
+            else std::this_thread::yield();
+        }
+    });
+
+    /* Consumer: mix single pops and batches; every item exactly once, in
+     * order. Keeps draining after a mismatch so the producer can finish */
+    uint32_t expect = 0;
+    bool     ok     = true;
+    Item     batch[8];
+    while (expect < COUNT) {
+        size_t n;
+        if (expect & 1) {
+            n = ring.pop(batch[0]) ? 1 : 0;
+        } else {
+            n = ring.popBatch(batch, 8);
+        }
+        for (size_t i = 0; i < n; i++) {
+            ok = ok && batch[i].seq == expect && batch[i].check == ~expect * 2654435761u;
+            expect++;
+        }
+        if (n == 0) std::this_thread::yield();
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE_MESSAGE(ok, "item out of order, repeated or torn");
+    TEST_ASSERT_EQUAL(COUNT, expect);
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_ring_pops_nothing);
+    RUN_TEST(test_full_ring_rejects_and_counts_drops);
+    RUN_TEST(test_wraparound_keeps_fifo_order);
+    RUN_TEST(test_pop_batch_limits_and_wraps);
+    RUN_TEST(test_producer_consumer_stress);
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Decode the HeatPress binary telemetry stream (see src/diag/telemetry_frame.h).
+
+Reads frames from a capture file, stdin or a serial port, checks COBS framing
+and CRC, and writes one CSV row per sample. Optionally writes a replay trace
+(time_ms,grams) that `program sim --trace` accepts: CSV, or the binary HPTR
+format when the file name ends in .bin.
+
+    # capture on the device: type "telem on" in the serial console first
+    telemetry_decode.py --port /dev/ttyUSB0 --csv run.csv --trace run_trace.csv
+    telemetry_decode.py capture.bin --csv run.csv
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+TYPE_SAMPLE = 0x01
+SAMPLE_FMT = "<BBHIiiiH"            # type, state, seq, t_us, raw, unfiltered, filtered, dropped
+SAMPLE_LEN = struct.calcsize(SAMPLE_FMT)
+STATES = ["CALIBRATING", "IDLE", "TIMING", "ALERT"]
+CG_PER_GRAM = 100.0
+
+
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def read_chunks(args):
+    if args.port:
+        try:
+            import serial
+        except ImportError:
+            sys.exit("reading a serial port needs pyserial (pip install pyserial)")
+        with serial.Serial(args.port, args.baud, timeout=1) as port:
+            try:
+                while True:
+                    chunk = port.read(4096)
+                    if chunk:
+                        yield chunk
+            except KeyboardInterrupt:
+                return
+    elif args.input in (None, "-"):
+        while True:
+            chunk = sys.stdin.buffer.read(4096)
+            if not chunk:
+                return
+            yield chunk
+    else:
+        with open(args.input, "rb") as f:
+            while True:
+                chunk = f.read(65536)
+                if not chunk:
+                    return
+                yield chunk
+
+
+class Stats:
+    def __init__(self):
+        self.frames = 0
+        self.crc_errors = 0
+        self.malformed = 0
+        self.lost = 0
+        self.device_dropped = 0
+
+
+def decode_frames(chunks, stats):
+    """Yield sample tuples from a byte stream, resyncing on every 0x00."""
+    buf = bytearray()
+    last_seq = None
+    for chunk in chunks:
+        buf += chunk
+        while True:
+            end = buf.find(0)
+            if end < 0:
+                break
+            raw = bytes(buf[:end])
+            del buf[:end + 1]
+            if not raw:
+                continue
+
+            frame = cobs_decode(raw)
+            if frame is None or len(frame) != SAMPLE_LEN + 2 or frame[0] != TYPE_SAMPLE:
+                stats.malformed += 1
+                continue
+            payload, crc = frame[:-2], struct.unpack("<H", frame[-2:])[0]
+            if crc16_ccitt(payload) != crc:
+                stats.crc_errors += 1
+                continue
+
+            sample = struct.unpack(SAMPLE_FMT, payload)
+            seq = sample[2]
+            if last_seq is not None:
+                stats.lost += (seq - last_seq - 1) & 0xFFFF
+            last_seq = seq
+            stats.frames += 1
+            stats.device_dropped = sample[7]
+            yield sample
+
+
+def write_trace(path, rows):
+    if path.endswith(".bin"):
+        with open(path, "wb") as f:
+            f.write(b"HPTR" + struct.pack("<II", 1, len(rows)))
+            for time_ms, grams in rows:
+                f.write(struct.pack("<If", int(round(time_ms)), grams))
+    else:
+        with open(path, "w", newline="") as f:
+            f.write("time_ms,grams\n")
+            for time_ms, grams in rows:
+                f.write("%.3f,%.2f\n" % (time_ms, grams))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("input", nargs="?", help="capture file ('-' or omitted: stdin)")
+    ap.add_argument("--port", help="read live from this serial port instead")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--csv", help="sample CSV output (default: stdout)")
+    ap.add_argument("--trace", help="replay trace for the simulator (.csv or .bin)")
+    args = ap.parse_args()
+
+    stats = Stats()
+    out = open(args.csv, "w", newline="") if args.csv else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(["time_us", "seq", "state", "raw_counts", "unfiltered_g", "filtered_g"])
+
+    trace = []
+    t0 = None
+    epoch = 0          # the device timestamp is a wrapping 32-bit µs counter
+    last_t = None
+    for _, state, seq, t_us, raw, unfiltered, filtered, _ in decode_frames(read_chunks(args), stats):
+        if last_t is not None and t_us < last_t:
+            epoch += 1 << 32
+        last_t = t_us
+        t = epoch + t_us
+        if t0 is None:
+            t0 = t
+
+        name = STATES[state] if state < len(STATES) else str(state)
+        writer.writerow([t, seq, name, raw,
+                         "%.2f" % (unfiltered / CG_PER_GRAM), "%.2f" % (filtered / CG_PER_GRAM)])
+        if args.trace:
+            trace.append(((t - t0) / 1000.0, unfiltered / CG_PER_GRAM))
+
+    if out is not sys.stdout:
+        out.close()
+    if args.trace:
+        write_trace(args.trace, trace)
+
+    print("%d frames, %d lost in transit, %d dropped on device, %d CRC errors, %d malformed"
+          % (stats.frames, stats.lost, stats.device_dropped, stats.crc_errors, stats.malformed),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()